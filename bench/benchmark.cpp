@@ -0,0 +1,331 @@
+#include "process.h"
+#include "event_sim.h"
+#include "replay.h"
+#include "generator.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+// benchmark: 量測各個排程核心的決策吞吐量 (decisions/sec、ns/decision)、peak RSS 與每次執行的配置次數
+//   benchmark [--counts 10,100,...,1e7] [--arrivals batch,uniform,poisson,bursty]
+//             [--bursts uniform,exponential,pareto,lognormal] [--algos sjf,rr,mlfq,custom,cfs,edf,edf-hybrid]
+//             [--load 0.9] [--deadlines 0] [--seed 1] [--min-time 0.2] [--out bench_results.json]
+
+// ---- 配置次數：取代全域 operator new，只在這個執行檔中生效 ----
+
+static atomic<long long> allocation_count(0);
+
+void* operator new(size_t size) {
+    allocation_count.fetch_add(1, memory_order_relaxed);
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr) throw bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+// ---- peak RSS ----
+
+// Linux 可以透過 clear_refs 重設 high-water mark，讓每個 case 各自量測；
+// 其他平台 (或沒有權限時) 回報的是整個程序到目前為止的最大值
+static void reset_peak_rss() {
+#ifdef __linux__
+    ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs.is_open()) clear_refs << "5";
+#endif
+}
+
+static long long peak_rss_kb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize / 1024;
+#else
+#ifdef __linux__
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return atoll(line.c_str() + 6);
+    }
+#endif
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // macOS 單位為 bytes
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// ---- workload ----
+
+struct BenchCase {
+    string algorithm;
+    ArrivalPattern arrival;
+    BurstShape burst;
+    long long num_processes;
+    double load; // 平均到達率 * 平均 burst time
+    double deadline_fraction; // 有 deadline 的行程比例 (WorkloadSpec::deadline_fraction)
+    unsigned int seed;
+};
+
+// 行程由 WorkloadGenerator 即時產生，不需要先把整個 workload 放進記憶體，
+// 所以 10^7 個行程時記憶體只跟同時存在的行程數量有關
+static WorkloadSpec bench_workload_spec(const BenchCase& bench_case) {
+    WorkloadSpec spec = default_workload_spec(bench_case.num_processes, bench_case.seed);
+    spec.arrival = bench_case.arrival;
+    spec.burst = bench_case.burst;
+    spec.load = bench_case.load;
+    spec.deadline_fraction = bench_case.deadline_fraction;
+    return spec;
+}
+
+// ---- 執行與量測 ----
+
+struct BenchResult {
+    BenchCase bench_case;
+    int runs;
+    double seconds_per_run;            // 含 workload 產生
+    double generation_seconds_per_run; // 只產生 workload 的時間
+    long long decisions;
+    double decisions_per_sec;
+    double ns_per_decision;
+    long long peak_rss_kb;
+    double allocations_per_run;
+    long long context_switches;
+    SimTime makespan;
+};
+
+static double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static BenchResult run_case(const BenchCase& bench_case, const SchedulerCore& scheduler, double min_time) {
+    BenchResult result;
+    result.bench_case = bench_case;
+
+    // 只產生 workload 的時間，之後從總時間扣掉
+    int generation_runs = 0;
+    double generation_seconds = 0;
+    while (generation_runs == 0 || generation_seconds < min_time) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        WorkloadGenerator source(bench_workload_spec(bench_case));
+        while (source.has_next()) source.next();
+        generation_seconds += seconds_since(start);
+        generation_runs++;
+    }
+    result.generation_seconds_per_run = generation_seconds / generation_runs;
+
+    // 重複執行直到累積時間超過 min_time，小的 workload 才量得準
+    reset_peak_rss();
+    result.runs = 0;
+    double total_seconds = 0;
+    long long total_allocations = 0;
+    while (result.runs == 0 || total_seconds < min_time) {
+        SimTime makespan = 0;
+        long long allocations_before = allocation_count.load(memory_order_relaxed);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        {
+            WorkloadGenerator source(bench_workload_spec(bench_case));
+            EventSimulator sim(source, [&makespan](const ProcessTable& table, int idx) {
+                makespan = max(makespan, table.completion_time[idx]);
+            }, false);
+            scheduler(sim);
+            result.decisions = sim.get_dispatches();
+            result.context_switches = sim.get_context_switches();
+        }
+        total_seconds += seconds_since(start);
+        total_allocations += allocation_count.load(memory_order_relaxed) - allocations_before;
+        result.makespan = makespan;
+        result.runs++;
+    }
+    result.peak_rss_kb = peak_rss_kb();
+    result.seconds_per_run = total_seconds / result.runs;
+    result.allocations_per_run = static_cast<double>(total_allocations) / result.runs;
+
+    double scheduling_seconds = max(1e-12, result.seconds_per_run - result.generation_seconds_per_run);
+    result.decisions_per_sec = result.decisions / scheduling_seconds;
+    result.ns_per_decision = result.decisions > 0 ? scheduling_seconds * 1e9 / result.decisions : 0;
+    return result;
+}
+
+// ---- 輸出 ----
+
+static void print_result_row(const BenchResult& r) {
+    cout << setw(9) << r.bench_case.algorithm << " | "
+         << setw(7) << arrival_pattern_name(r.bench_case.arrival) << " | "
+         << setw(11) << burst_shape_name(r.bench_case.burst) << " | "
+         << setw(10) << r.bench_case.num_processes << " | "
+         << setw(12) << r.decisions << " | "
+         << setw(14) << fixed << setprecision(0) << r.decisions_per_sec << " | "
+         << setw(11) << setprecision(1) << r.ns_per_decision << " | "
+         << setw(13) << r.peak_rss_kb << " | "
+         << setw(10) << setprecision(1) << r.allocations_per_run << "\n"
+         << defaultfloat;
+    cout.flush();
+}
+
+static void save_results_to_json(const vector<BenchResult>& results, double min_time, const string& filename) {
+    ofstream outfile(filename);
+    if (!outfile.is_open()) {
+        cerr << "Error: Could not open file " << filename << " for writing benchmark results." << endl;
+        return;
+    }
+
+    outfile << setprecision(10);
+    outfile << "{\n  \"schema_version\": 1,\n  \"min_time_seconds\": " << min_time << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        outfile << (i == 0 ? "\n" : ",\n")
+                << "    {\"algorithm\": \"" << r.bench_case.algorithm << "\""
+                << ", \"arrival\": \"" << arrival_pattern_name(r.bench_case.arrival) << "\""
+                << ", \"burst\": \"" << burst_shape_name(r.bench_case.burst) << "\""
+                << ", \"processes\": " << r.bench_case.num_processes
+                << ", \"load\": " << r.bench_case.load
+                << ", \"deadline_fraction\": " << r.bench_case.deadline_fraction
+                << ", \"seed\": " << r.bench_case.seed
+                << ", \"runs\": " << r.runs
+                << ", \"seconds_per_run\": " << r.seconds_per_run
+                << ", \"generation_seconds_per_run\": " << r.generation_seconds_per_run
+                << ", \"decisions\": " << r.decisions
+                << ", \"decisions_per_sec\": " << r.decisions_per_sec
+                << ", \"ns_per_decision\": " << r.ns_per_decision
+                << ", \"peak_rss_kb\": " << r.peak_rss_kb
+                << ", \"allocations_per_run\": " << r.allocations_per_run
+                << ", \"context_switches\": " << r.context_switches
+                << ", \"makespan\": " << r.makespan << "}";
+    }
+    outfile << "\n  ]\n}\n";
+
+    outfile.close();
+    cout << "Benchmark results saved to " << filename << endl;
+}
+
+// ---- 命令列 ----
+
+static vector<string> split_list(const string& text) {
+    vector<string> items;
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+int main(int argc, char* argv[]) {
+    vector<long long> counts = {10, 100, 1000, 10000, 100000, 1000000, 10000000};
+    vector<ArrivalPattern> arrivals = {ARRIVAL_BATCH, ARRIVAL_UNIFORM, ARRIVAL_POISSON};
+    vector<BurstShape> bursts = {BURST_UNIFORM, BURST_EXPONENTIAL, BURST_PARETO};
+    vector<string> algorithms = {"sjf", "rr", "mlfq", "custom", "cfs", "edf"};
+    double load = 0.9;
+    double deadline_fraction = 0;
+    unsigned int seed = 1;
+    double min_time = 0.2;
+    string out_filename = "bench_results.json";
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Error: missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--counts") {
+            counts.clear();
+            for (const auto& item : split_list(value)) {
+                counts.push_back(llround(atof(item.c_str()))); // 也接受 1e7 這種寫法
+            }
+        } else if (arg == "--arrivals") {
+            arrivals.clear();
+            for (const auto& item : split_list(value)) {
+                ArrivalPattern arrival;
+                if (!parse_arrival_pattern(item, arrival)) {
+                    cerr << "Error: unknown arrival distribution " << item << endl;
+                    return 1;
+                }
+                arrivals.push_back(arrival);
+            }
+        } else if (arg == "--bursts") {
+            bursts.clear();
+            for (const auto& item : split_list(value)) {
+                BurstShape burst;
+                if (!parse_burst_shape(item, burst)) {
+                    cerr << "Error: unknown burst distribution " << item << endl;
+                    return 1;
+                }
+                bursts.push_back(burst);
+            }
+        } else if (arg == "--algos") {
+            algorithms = split_list(value);
+        } else if (arg == "--load") {
+            load = atof(value.c_str());
+        } else if (arg == "--deadlines") {
+            deadline_fraction = atof(value.c_str());
+        } else if (arg == "--seed") {
+            seed = atoi(value.c_str());
+        } else if (arg == "--min-time") {
+            min_time = atof(value.c_str());
+        } else if (arg == "--out") {
+            out_filename = value;
+        } else {
+            cerr << "Error: unknown option " << arg << endl;
+            return 1;
+        }
+    }
+    if (load <= 0) {
+        cerr << "Error: --load must be positive" << endl;
+        return 1;
+    }
+    if (deadline_fraction < 0 || deadline_fraction > 1) {
+        cerr << "Error: --deadlines must be in [0, 1]" << endl;
+        return 1;
+    }
+    for (const auto& name : algorithms) {
+        if (!scheduler_by_name(name)) {
+            cerr << "Error: unknown algorithm " << name << endl;
+            return 1;
+        }
+    }
+
+    cout << "Algorithm | Arrival |       Burst |  Processes |    Decisions |  Decisions/sec | ns/decision | Peak RSS (KB) | Allocs/run\n";
+    cout << "-------------------------------------------------------------------------------------------------------------------------\n";
+
+    vector<BenchResult> results;
+    for (long long count : counts) {
+        for (ArrivalPattern arrival : arrivals) {
+            for (BurstShape burst : bursts) {
+                for (const auto& name : algorithms) {
+                    BenchCase bench_case = BenchCase{name, arrival, burst, count, load, deadline_fraction, seed};
+                    results.push_back(run_case(bench_case, scheduler_by_name(name), min_time));
+                    print_result_row(results.back());
+                }
+            }
+        }
+    }
+
+    cout << "-------------------------------------------------------------------------------------------------------------------------\n";
+    save_results_to_json(results, min_time, out_filename);
+    return 0;
+}
@@ -0,0 +1,36 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "process.h"
+#include <string>
+#include <fstream>
+#include <cstdint>
+
+// checkpoint 檔："CKPT" + uint32 version，之後依時間順序每個 checkpoint 一筆記錄：
+// int64 模擬時間、uint32 演算法名稱長度 + 名稱、uint64 state 長度、uint64 state 的 FNV-1a checksum、state
+// state 是 snapshot.h 格式的 byte 序列，只能在同一個平台與同一版程式讀回
+struct Checkpoint {
+    SimTime time;
+    std::string algorithm;
+    std::string state;
+};
+
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(const std::string& filename);
+
+    bool is_open() const { return output.is_open(); }
+    void write(SimTime time, const std::string& algorithm, const std::string& state);
+    long long written() const { return count; }
+    bool close(); // 全部寫入成功時回傳 true
+
+private:
+    std::ofstream output;
+    long long count;
+};
+
+// 找出 algorithm 在時間 at 之前 (含) 最後一個 checkpoint，at = -1 表示最後一個
+// checksum 不符的記錄視為損毀，檔案不存在、格式錯誤或找不到時回傳 false (會輸出錯誤訊息)
+bool find_checkpoint(const std::string& filename, const std::string& algorithm, SimTime at, Checkpoint& checkpoint);
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,128 @@
+#ifndef COLUMNAR_H
+#define COLUMNAR_H
+
+#include "process.h"
+#include "event_sim.h"
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+
+// 欄位式 (columnar) 二進位 workload 格式，用 mmap 直接讀取，不需要解析文字：
+//   header (24 bytes): "WKLD" + uint32 version + uint64 count + uint64 reserved
+//   之後依序是 4 個固定寬度的 int32 欄位，各 count 筆：
+//   process id, arrival time, burst time, priority
+//   version 2 多一個 deadline 欄位 (相對於 arrival time，-1 表示沒有 deadline)
+// 每一列依 arrival time 非遞減排序，所以可以直接當作 ArrivalSource 使用
+
+struct ColumnarHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+    uint64_t reserved;
+};
+
+// 指向 mmap 區域中某個欄位的唯讀 view (zero-copy)
+class ColumnView {
+public:
+    ColumnView() : values(nullptr), length(0) {}
+    ColumnView(const int32_t* values, size_t length) : values(values), length(length) {}
+
+    int32_t operator[](size_t i) const { return values[i]; }
+    size_t size() const { return length; }
+    const int32_t* data() const { return values; }
+
+private:
+    const int32_t* values;
+    size_t length;
+};
+
+class MappedWorkload {
+public:
+    MappedWorkload();
+    ~MappedWorkload();
+
+    MappedWorkload(const MappedWorkload&) = delete;
+    MappedWorkload& operator=(const MappedWorkload&) = delete;
+
+    // 開檔並 mmap，格式錯誤或有不合法的列 (未依 arrival time 排序、burst <= 0、priority 或 deadline 超出範圍) 時回傳 false
+    bool open(const std::string& filename);
+    void close();
+
+    size_t size() const { return count; }
+    ColumnView ids() const { return column(0); }
+    ColumnView arrival_times() const { return column(1); }
+    ColumnView burst_times() const { return column(2); }
+    ColumnView priorities() const { return column(3); }
+    bool has_deadlines() const { return num_columns > 4; }
+    ColumnView deadlines() const { return has_deadlines() ? column(4) : ColumnView(); } // version 1 時為空的
+
+private:
+    ColumnView column(int index) const;
+    bool validate_rows(const std::string& filename) const;
+
+    const unsigned char* mapped;
+    size_t mapped_size;
+    size_t count;
+    int num_columns;
+#ifdef _WIN32
+    void* file_handle;
+    void* mapping_handle;
+#else
+    int fd;
+#endif
+};
+
+// 依列的順序把 mmap 的欄位當作行程來源，只有在 admit 時才建立 Process
+class MappedWorkloadSource : public ArrivalSource {
+public:
+    explicit MappedWorkloadSource(const MappedWorkload& workload);
+
+    bool has_next() override { return cursor < arrival_times.size(); }
+    SimTime peek_arrival_time() override { return arrival_times[cursor]; }
+    Process next() override;
+    void skip(long long count) override { cursor = std::min<size_t>(cursor + count, arrival_times.size()); }
+
+private:
+    ColumnView ids;
+    ColumnView arrival_times;
+    ColumnView burst_times;
+    ColumnView priorities;
+    ColumnView deadlines;
+    size_t cursor;
+};
+
+// 逐筆寫入 columnar 檔案 (依 arrival time 順序)：行程數必須事先知道，
+// 每個欄位先緩衝在記憶體，滿了再寫到該欄位在檔案中的位置，所以記憶體用量與行程數無關
+// with_deadlines = true 時寫成 version 2 (含 deadline 欄位)
+class ColumnarWriter {
+public:
+    ColumnarWriter(const std::string& filename, size_t count, bool with_deadlines = false);
+
+    bool is_open() const { return outfile.is_open(); }
+    void write(const Process& p);
+    // 寫入的筆數與 count 不同或寫檔失敗時回傳 false
+    bool close();
+
+private:
+    static const size_t BUFFERED_ROWS = 1 << 16;
+
+    void flush_columns();
+
+    std::ofstream outfile;
+    size_t count;
+    size_t written; // 已經寫到檔案的列數
+    int num_columns;
+    std::vector<int32_t> columns[5];
+};
+
+// 檔案開頭是否為 columnar workload 的 magic
+bool is_columnar_workload(const std::string& filename);
+
+// 把記憶體中的行程 (例如 generate_processes 的輸出) 依 arrival time 排序後轉成 columnar 檔案
+// (有任何行程有 deadline 時寫成 version 2)
+bool save_processes_to_columnar(const std::vector<Process>& processes, const std::string& filename);
+
+#endif // COLUMNAR_H
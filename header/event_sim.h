@@ -0,0 +1,229 @@
+#ifndef EVENT_SIM_H
+#define EVENT_SIM_H
+
+#include "process.h"
+#include "gantt.h"
+#include "telemetry.h"
+#include "snapshot.h"
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <memory>
+#include <functional>
+
+// 離散事件模擬 (discrete-event simulation) 核心
+// 時間直接跳到下一個事件 (arrival / completion / quantum expiry / aging deadline / I/O completion)，
+// 不再每 1ms 跑一次迴圈，所以執行時間只跟事件數量有關，跟模擬的毫秒數無關
+
+enum EventType {
+    EVENT_COMPLETION,     // 目前的 CPU burst 執行完畢 (最後一個 CPU burst 時行程完成，否則開始 I/O)
+    EVENT_QUANTUM_EXPIRY, // time quantum 用完
+    EVENT_AGING,          // 等待時間到達 aging threshold
+    EVENT_IO_COMPLETION   // I/O burst 結束，行程回到就緒佇列
+};
+
+struct Event {
+    SimTime time;
+    EventType type;
+    int proc_idx; // processes slot 的索引
+    int token;    // 排入時行程的 token，與目前 token 不同代表事件已被取消
+};
+
+// 行程來源：依 arrival time (非遞減) 的順序一個一個提供行程
+class ArrivalSource {
+public:
+    virtual ~ArrivalSource() {}
+    virtual bool has_next() = 0;
+    virtual SimTime peek_arrival_time() = 0; // 呼叫前需確認 has_next()
+    virtual Process next() = 0;
+    // admit 時把下一個行程直接寫到 table 的第 slot 列 (該列已經存在)
+    // 預設經過 next() 建立 Process；能直接從自己的欄位填入的來源可以覆寫，省下每次 admit 的配置
+    virtual void next_into(ProcessTable& table, size_t slot) { table.assign(slot, next()); }
+    // 跳過接下來的 count 個行程 (從 checkpoint 繼續時使用)，可以直接定位的來源可以覆寫
+    virtual void skip(long long count) {
+        for (long long i = 0; i < count && has_next(); i++) next();
+    }
+};
+
+// 以記憶體中的 vector 當作來源 (依 arrival time stable sort，同時到達時維持原本順序)
+class VectorArrivalSource : public ArrivalSource {
+public:
+    explicit VectorArrivalSource(const std::vector<Process>& processes);
+
+    bool has_next() override { return cursor < order.size(); }
+    SimTime peek_arrival_time() override { return processes[order[cursor]].arrival_time; }
+    Process next() override { return processes[order[cursor++]]; }
+    void skip(long long count) override { cursor = std::min<size_t>(cursor + count, order.size()); }
+
+private:
+    const std::vector<Process>& processes;
+    std::vector<int> order;
+    size_t cursor;
+};
+
+// CPU 與 I/O 的使用時間 (ms)：utilization = busy / makespan，
+// I/O overlap = overlap / io_active (I/O 進行中的時間有多少比例 CPU 同時在執行行程)
+struct CpuUsage {
+    SimTime busy;      // CPU 執行行程的時間
+    SimTime io_active; // 至少有一個行程在做 I/O 的時間
+    SimTime overlap;   // CPU 執行行程，同時有行程在做 I/O 的時間
+    SimTime switching; // CPU 花在 context switch 的時間 (不算在 busy)
+};
+
+// context switch 的成本 (ms)，在 dispatch 之後、行程開始執行之前佔用 CPU
+// - dispatch：每次 context switch (換成另一個行程) 的固定成本
+// - cache_warmup：行程的 cache 完全變冷時重新暖機的時間，
+//   離開 CPU t ms 之後為 cache_warmup x (1 - exp(-t / cache_decay))，沒執行過的行程為完整的 cache_warmup；
+//   CPU 上一個執行的就是這個行程時 (中間只有空閒) cache 還是熱的，沒有 penalty
+// 全部為 0 時 context switch 不花時間 (預設，結果與沒有這個模型時相同)
+struct SwitchCostModel {
+    SimTime dispatch;
+    SimTime cache_warmup;
+    SimTime cache_decay; // 0 表示離開 CPU 就完全變冷
+};
+
+// 預設：context switch 不花時間
+SwitchCostModel default_switch_cost_model();
+// 參數不合理時輸出錯誤訊息並回傳 false
+bool validate_switch_cost_model(const SwitchCostModel& model);
+
+// 行程完成時呼叫，傳入行程表與 slot 索引 (completion_time 已設定好)
+typedef std::function<void(const ProcessTable&, int)> CompletionCallback;
+
+// 接收 checkpoint：state 是模擬器、執行中的行程、就緒佇列與 aging 的完整狀態
+class CheckpointSink {
+public:
+    virtual ~CheckpointSink() {}
+    virtual void write_checkpoint(SimTime time, const std::string& state) = 0;
+};
+
+// 事件 heap 的順序：時間早的先，同時間時 slot 索引小的先
+struct EventLater {
+    bool operator()(const Event& a, const Event& b) const {
+        if (a.time != b.time) return a.time > b.time;
+        return a.proc_idx > b.proc_idx;
+    }
+};
+
+// 一次模擬的可變狀態 (slot 行程表、事件 heap 等)
+// 同一個 arena 可以依序給多次模擬使用，保留上一次的容量，重複執行時幾乎不需要重新配置
+// 同一時間只能給一個 EventSimulator 使用 (多 thread 時每個 thread 各自一個)
+struct SimulationArena {
+    ProcessTable slots;
+    std::vector<int> free_slots;
+    std::vector<int> tokens;
+    std::vector<long long> admission_index;
+    std::vector<Event> events; // 以 EventLater 排序的 binary heap
+
+    void clear();
+};
+
+class EventSimulator {
+public:
+    // record_gantt = false 時不記錄甘特圖 (串流重播超大 trace 時使用)
+    // arena 為 nullptr 時使用自己的 arena
+    EventSimulator(ArrivalSource& source, CompletionCallback on_complete, bool record_gantt = true,
+                   SimulationArena* arena = nullptr);
+
+    SimTime now() const { return current_time; }
+
+    // 已到達但尚未完成的行程存放在 slot 中，完成後 slot 會被重複使用，
+    // 所以記憶體只跟同時存在的行程數量有關，跟整個 workload 的大小無關
+    ProcessTable& get_processes() { return arena.slots; }
+    size_t slot_count() const { return arena.slots.size(); } // per-process 狀態陣列需要的大小
+    // 該 slot 的行程是第幾個被 admit 的 (從 0 開始)，也就是它在來源中的順序
+    long long admission_index(int proc_idx) const { return arena.admission_index[proc_idx]; }
+    bool done(); // 沒有尚未到達或尚未完成的行程
+
+    // arrival: 依 arrival time 排序的來源，每個行程只會被 admit 一次
+    bool has_arrival_due();
+    int pop_arrival(); // 把下一個已到達的行程放進 slot，回傳 slot 索引
+    void complete(int proc_idx); // 記錄 completion_time、通知 callback 並釋放 slot
+    // 等待中的行程移到其他 CPU (多核心模擬)：取消事件並釋放 slot，呼叫者先複製 slot 的內容
+    void release(int proc_idx);
+
+    // 給多核心模擬的 load balancing 使用
+    size_t ready_count() const { return live_processes - blocked_processes; } // 不在做 I/O 的行程 (含執行中的行程)
+    SimTime ready_work() const { return ready_work_total; } // 這些行程目前這個 CPU burst 剩餘時間的總和
+
+    // I/O：每個行程的 I/O 各自進行 (不互相等待)，I/O 期間行程不在 CPU 也不在就緒佇列 (blocked)
+    bool last_burst(int proc_idx) const; // 目前的 CPU burst 是否為最後一個
+    void start_io(int proc_idx);  // 目前的 CPU burst 結束，開始下一個 I/O burst 並排定 EVENT_IO_COMPLETION
+    void finish_io(int proc_idx); // I/O 結束，remaining_burst_time 設為下一個 CPU burst
+
+    // timed events (completion / quantum expiry / aging)
+    void schedule(SimTime time, EventType type, int proc_idx);
+    void cancel_events(int proc_idx); // 讓該行程所有尚未發生的事件失效
+    bool has_event_due();
+    Event pop_event();
+    SimTime peek_event_time(); // 下一個 timed event (不含 arrival) 的時間，沒有時回傳 -1
+
+    // 下一個事件 (含 arrival) 的時間，沒有任何事件時回傳 -1
+    SimTime next_event_time();
+
+    // CPU bookkeeping
+    void set_switch_cost(const SwitchCostModel& model) { switch_cost = model; }
+    // context switch 計數與 start_time，回傳這次 dispatch 的 switch 成本 (行程在這之後才開始執行)
+    SimTime dispatch(int proc_idx);
+    void run_until(int proc_idx, SimTime end_time); // 先付完 switch 成本再執行到 end_time，並記錄甘特圖
+    void idle_until(SimTime end_time);              // CPU 空閒到 end_time
+
+    long long get_context_switches() const { return context_switches; }
+    long long get_dispatches() const { return dispatches; } // 排程決策次數 (每次 dispatch 算一次)
+    CpuUsage get_cpu_usage() const { return usage; }
+    const GanttTimeline& get_gantt_timeline() const { return gantt_timeline; }
+    // 甘特圖區間一確定就交給 sink (例如背景寫檔)，模擬結束後呼叫 flush_gantt() 交出最後一段
+    void stream_gantt_to(GanttSink* sink) { gantt_timeline.stream_to(sink); }
+    void flush_gantt() { gantt_timeline.flush(); }
+    Telemetry& get_telemetry() { return telemetry; } // 只有 SCHED_TELEMETRY 時才有資料
+
+    // checkpoint：引擎在每一輪迴圈開頭檢查 checkpoint_due()，到期時把 save() 之後接著寫入引擎狀態的結果交給
+    // write_checkpoint()，再由 sink 保存；每隔 interval ms (模擬時間) 一次
+    void checkpoint_every(SimTime interval, CheckpointSink* sink);
+    bool checkpoint_due() const { return checkpoint_sink != nullptr && current_time >= next_checkpoint_time; }
+    void save(SnapshotWriter& out) const; // 模擬器本身的狀態 (來源的位置以 admit 的數量表示)
+    void write_checkpoint(const SnapshotWriter& state);
+
+    // resume：在排程核心開始之前還原模擬器的狀態並跳過已經 admit 的行程 (source 必須從頭開始)，
+    // 引擎開始時再從 resume_state() 讀出自己的狀態，最後呼叫 finish_resume() 確認整份 state 都剛好讀完
+    // switch cost 不在 snapshot 中，使用這次設定的值
+    void resume_from(const std::string& state);
+    SnapshotReader* resume_state() { return resuming ? resume_reader.get() : nullptr; }
+    bool finish_resume();
+    bool resume_failed() const { return resume_error; }
+
+private:
+    void drop_cancelled();
+    SimTime warmup_penalty(int proc_idx) const;
+
+    ArrivalSource& source;
+    CompletionCallback on_complete;
+
+    SimulationArena own_arena;
+    SimulationArena& arena;
+    size_t live_processes;
+    size_t blocked_processes; // 正在做 I/O 的行程數
+    SimTime ready_work_total;
+    long long admitted;
+
+    bool record_gantt;
+    GanttTimeline gantt_timeline;
+    Telemetry telemetry;
+    SimTime current_time;
+    long long context_switches;
+    long long dispatches;
+    CpuUsage usage;
+    int prev_proc_id; // 上一個執行的 process ID，-1 表示CPU空閒
+    SwitchCostModel switch_cost;
+    SimTime pending_switch; // 目前 dispatch 還沒付完的 switch 成本
+    int cache_owner_id;     // cache 中是哪個行程的資料 (最後執行的 process ID，空閒時不變)
+
+    CheckpointSink* checkpoint_sink;
+    SimTime checkpoint_interval;
+    SimTime next_checkpoint_time;
+    std::unique_ptr<SnapshotReader> resume_reader; // 讀取 resume 的 state (state 由呼叫者保留)
+    bool resuming;
+    bool resume_error;
+};
+
+#endif // EVENT_SIM_H
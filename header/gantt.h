@@ -0,0 +1,69 @@
+#ifndef GANTT_H
+#define GANTT_H
+
+#include <vector>
+#include <cstddef>
+#include "process.h"
+
+// 甘特圖的一段連續區間：[start, end) 期間由 process_id 使用 CPU
+// (-1 表示CPU空閒，GANTT_SWITCH 表示 CPU 在做 context switch，見 SwitchCostModel)
+static const int GANTT_SWITCH = -2;
+
+// 甘特圖檔案的格式：CSV (Start,End,ProcessID) 或 binary ("GNTT" header + int64 start/end、int32 pid)
+enum GanttFormat {
+    GANTT_CSV,
+    GANTT_BINARY
+};
+
+struct GanttSegment {
+    SimTime start;
+    SimTime end;
+    int process_id;
+};
+
+// 接收已經確定的甘特圖區間 (例如直接寫檔)
+class GanttSink {
+public:
+    virtual ~GanttSink() {}
+    virtual void write_segment(const GanttSegment& segment) = 0;
+};
+
+// run-length encoded 甘特圖：連續存放 (start, end, pid) 區間，
+// 不再每 1ms 配置一個 map 節點，記憶體只跟區間數量有關
+class GanttTimeline {
+public:
+    GanttTimeline() : sink(nullptr) {}
+
+    // 加入 [start, end) 區間，若與上一段相接且是同一個行程則直接延長
+    void append(SimTime start, SimTime end, int process_id) {
+        if (start >= end) return;
+        if (!segments.empty() && segments.back().end == start && segments.back().process_id == process_id) {
+            segments.back().end = end;
+            return;
+        }
+        if (sink != nullptr && !segments.empty()) {
+            sink->write_segment(segments.back()); // 上一段不會再被延長
+            segments.clear();
+        }
+        segments.push_back(GanttSegment{start, end, process_id});
+    }
+
+    // 串流模式：不會再延長的區間直接交給 sink，記憶體中只保留最後一段，flush() 時交出
+    void stream_to(GanttSink* output) { sink = output; }
+    void flush() {
+        if (sink == nullptr) return;
+        for (const auto& seg : segments) sink->write_segment(seg);
+        segments.clear();
+    }
+
+    bool empty() const { return segments.empty(); }
+    size_t size() const { return segments.size(); }
+    SimTime end_time() const { return segments.empty() ? 0 : segments.back().end; }
+    const std::vector<GanttSegment>& get_segments() const { return segments; }
+
+private:
+    std::vector<GanttSegment> segments;
+    GanttSink* sink;
+};
+
+#endif // GANTT_H
@@ -0,0 +1,115 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include "process.h"
+#include "event_sim.h"
+#include <vector>
+#include <string>
+#include <random>
+#include <cstdint>
+
+// 可重現的大量 workload 產生器：依 seed 即時產生行程 (arrival time 非遞減)，
+// 不需要先把整個 workload 放進記憶體，可以直接當作排程的 ArrivalSource 或逐筆寫成 trace
+// 只使用 mt19937_64 的輸出加上自己的 inverse-CDF 轉換，不依賴標準函式庫 <random> 分布的實作，
+// 所以同一個 seed 在不同的編譯器 / 平台上產生相同的 workload
+
+enum ArrivalPattern {
+    ARRIVAL_BATCH,   // 全部在時間 0 到達
+    ARRIVAL_UNIFORM, // 間隔為 [0, 2 * mean] 的均勻分布
+    ARRIVAL_POISSON, // 間隔為指數分布 (Poisson process)
+    ARRIVAL_BURSTY   // 兩狀態 Markov-modulated Poisson process：高峰期與離峰期交替
+};
+
+enum BurstShape {
+    BURST_UNIFORM,     // [mean / 3, 5 * mean / 3] 的整數 (mean 17 時為 [6, 28]，與 generate_processes 相同)
+    BURST_EXPONENTIAL,
+    BURST_PARETO,      // heavy tail，shape 為 pareto_alpha
+    BURST_LOGNORMAL    // heavy tail，log 的標準差為 lognormal_sigma
+};
+
+struct PriorityWeight {
+    int priority;
+    double weight; // 相對權重，不需要加總為 1
+};
+
+struct WorkloadSpec {
+    long long num_processes;
+    std::uint64_t seed;
+
+    ArrivalPattern arrival;
+    double load; // 平均到達率 x 平均 burst time (單一 CPU 的使用率)
+    // ARRIVAL_BURSTY：高峰期佔 burst_fraction 的時間，到達率是平均的 burst_factor 倍
+    // (須 burst_fraction * burst_factor <= 1)，高峰期平均長度為 burst_period (ms)
+    double burst_factor;
+    double burst_fraction;
+    double burst_period;
+
+    BurstShape burst;
+    double mean_burst;      // 平均 burst time (ms)
+    double pareto_alpha;    // BURST_PARETO，須 > 1
+    double lognormal_sigma; // BURST_LOGNORMAL
+    SimTime max_burst;      // heavy tail 的上限 (ms)
+
+    std::vector<PriorityWeight> priorities; // priority 的比例
+
+    // 有 deadline 的行程比例 (0 表示都沒有，不會多抽亂數，所以既有的 seed 產生相同的 workload)
+    // 相對 deadline 為 burst time x [1, deadline_slack] 的均勻分布
+    double deadline_fraction;
+    double deadline_slack;
+
+    // 有 I/O 的行程比例 (0 表示都是純 CPU 的行程，同樣不會多抽亂數)
+    // I/O 次數為平均 mean_io_count 的幾何分布 (>= 1)，把 burst time 平分成 I/O 次數 + 1 段 CPU burst
+    // 每次 I/O 的時間為平均 mean_io_burst (ms) 的指數分布；有 deadline 時 deadline 以 CPU + I/O 的總時間計算
+    double io_fraction;
+    double mean_io_count;
+    double mean_io_burst;
+};
+
+// 預設：Poisson arrival、load 0.9、平均 17ms 的 Pareto (alpha 1.5) burst、priority 1 ~ 3 各 1/3、沒有 deadline 與 I/O
+WorkloadSpec default_workload_spec(long long num_processes, std::uint64_t seed);
+
+// 參數不合理時輸出錯誤訊息並回傳 false
+bool validate_workload_spec(const WorkloadSpec& spec);
+
+// 命令列用的名稱：batch / uniform / poisson / bursty，uniform / exponential / pareto / lognormal
+const char* arrival_pattern_name(ArrivalPattern pattern);
+const char* burst_shape_name(BurstShape shape);
+bool parse_arrival_pattern(const std::string& name, ArrivalPattern& pattern);
+bool parse_burst_shape(const std::string& name, BurstShape& shape);
+
+class WorkloadGenerator : public ArrivalSource {
+public:
+    explicit WorkloadGenerator(const WorkloadSpec& spec);
+
+    bool has_next() override { return produced < spec.num_processes; }
+    SimTime peek_arrival_time() override { return static_cast<SimTime>(clock); }
+    Process next() override;
+
+    long long get_produced() const { return produced; }
+
+private:
+    double uniform();                 // (0, 1)
+    double exponential(double mean);
+    double normal();                  // 標準常態分布 (Box-Muller)
+    void advance_clock();             // 產生下一個行程的 arrival time
+    SimTime sample_burst();
+    int sample_priority();
+    std::vector<SimTime> sample_io(SimTime burst); // CPU / I/O 交替的 burst 序列，空的表示沒有 I/O
+    SimTime sample_deadline(SimTime burst); // -1 表示沒有 deadline
+
+    WorkloadSpec spec;
+    std::mt19937_64 gen;
+    long long produced;
+    double clock;       // 下一個行程的 arrival time
+    double mean_gap;    // 平均到達間隔 (ms)
+    bool peak;          // ARRIVAL_BURSTY：目前是否在高峰期
+    double state_end;   // ARRIVAL_BURSTY：目前狀態結束的時間
+    double spare_normal;
+    bool has_spare_normal;
+    std::vector<double> priority_cdf;
+};
+
+// 把整個 workload 產生到記憶體中 (sweep / tune / multi-core 這些需要共用 Workload 的模式)
+std::vector<Process> generate_processes(const WorkloadSpec& spec);
+
+#endif // GENERATOR_H
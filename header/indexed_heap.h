@@ -0,0 +1,97 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <vector>
+#include <cstddef>
+
+// 以行程索引為元素的 binary min-heap
+// pos[idx] 記錄每個索引在 heap 中的位置，所以 contains 是 O(1)，
+// push / pop / erase / update (key 改變後重新調整) 都是 O(log n)
+// Less(a, b) 比較兩個索引，a 應該排在 b 前面時回傳 true
+template <typename Less>
+class IndexedMinHeap {
+public:
+    IndexedMinHeap(size_t capacity, Less less) : pos(capacity, -1), less(less) {}
+
+    // 擴充可放入的索引範圍到 [0, capacity)
+    void grow(size_t capacity) {
+        if (capacity > pos.size()) pos.resize(capacity, -1);
+    }
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    bool contains(int idx) const { return pos[idx] != -1; }
+    int top() const { return heap[0]; }
+    // heap 陣列的內容 (依序 push 回空的 heap 會得到完全相同的排列，用於 snapshot)
+    const std::vector<int>& items() const { return heap; }
+
+    void push(int idx) {
+        pos[idx] = heap.size();
+        heap.push_back(idx);
+        sift_up(heap.size() - 1);
+    }
+
+    int pop() {
+        int idx = heap[0];
+        erase(idx);
+        return idx;
+    }
+
+    void erase(int idx) {
+        size_t i = pos[idx];
+        size_t last = heap.size() - 1;
+        if (i != last) {
+            swap_nodes(i, last);
+        }
+        heap.pop_back();
+        pos[idx] = -1;
+        if (i < heap.size()) {
+            sift_up(i);
+            sift_down(i);
+        }
+    }
+
+    // idx 的 key 已改變，重新調整位置
+    void update(int idx) {
+        sift_up(pos[idx]);
+        sift_down(pos[idx]);
+    }
+
+private:
+    void swap_nodes(size_t a, size_t b) {
+        int tmp = heap[a];
+        heap[a] = heap[b];
+        heap[b] = tmp;
+        pos[heap[a]] = a;
+        pos[heap[b]] = b;
+    }
+
+    void sift_up(size_t i) {
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (!less(heap[i], heap[parent])) break;
+            swap_nodes(i, parent);
+            i = parent;
+        }
+    }
+
+    void sift_down(size_t i) {
+        size_t n = heap.size();
+        while (true) {
+            size_t smallest = i;
+            size_t left = 2 * i + 1;
+            size_t right = left + 1;
+            if (left < n && less(heap[left], heap[smallest])) smallest = left;
+            if (right < n && less(heap[right], heap[smallest])) smallest = right;
+            if (smallest == i) break;
+            swap_nodes(i, smallest);
+            i = smallest;
+        }
+    }
+
+    std::vector<int> heap;
+    std::vector<int> pos; // 索引 -> heap 中的位置，-1 表示不在 heap 中
+    Less less;
+};
+
+#endif // INDEXED_HEAP_H
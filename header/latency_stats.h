@@ -0,0 +1,78 @@
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include "process.h"
+#include "snapshot.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// HDR-style log-linear histogram：小於 128 的值每個值一個 bucket (精確)，
+// 之後每個 2 的次方區間切成 64 個 bucket，相對誤差不超過 1/128
+// 記憶體只跟最大值的數量級有關 (最多約 3700 個 bucket)，跟記錄的數量無關，
+// 兩個 histogram 可以直接相加 (merge)，適合串流與平行統計
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(SimTime value); // 負值視為 0
+    void merge(const LatencyHistogram& other);
+
+    long long count() const { return total_count; }
+    SimTime min() const { return total_count > 0 ? min_value : 0; }
+    SimTime max() const { return total_count > 0 ? max_value : 0; }
+    double mean() const { return total_count > 0 ? (double)sum / total_count : 0; }
+    // percentile 介於 0 ~ 100，例如 99.9
+    SimTime percentile(double percentile) const;
+
+    // checkpoint / resume
+    void save(SnapshotWriter& out) const;
+    void load(SnapshotReader& in);
+
+private:
+    static size_t bucket_index(SimTime value);
+    static SimTime bucket_value(size_t index); // bucket 的代表值 (區間中點)
+
+    std::vector<long long> buckets; // 依需要擴充
+    long long total_count;
+    long long sum; // 整數累加，merge 的順序不影響結果
+    SimTime min_value;
+    SimTime max_value;
+};
+
+// 有 deadline 的行程：completion > arrival + deadline 就是 miss
+// tardiness (completion 超過 deadline 多久) 只記錄 miss 的行程
+struct DeadlineStats {
+    long long with_deadline;
+    long long missed;
+    LatencyHistogram tardiness;
+
+    DeadlineStats() : with_deadline(0), missed(0) {}
+    double miss_rate() const { return with_deadline > 0 ? (double)missed / with_deadline : 0; }
+    void record(const ProcessTable& processes, size_t i); // 沒有 deadline 的行程不計
+    void merge(const DeadlineStats& other);
+    void save(SnapshotWriter& out) const;
+    void load(SnapshotReader& in);
+};
+
+// 每個完成的行程記錄一次，不需要保留 per-process 資料
+// - waiting: completion - arrival - burst - I/O (在就緒佇列中等待的時間)
+// - turnaround: completion - arrival
+// - response: 第一次獲得CPU的時間 - arrival
+// - deadlines: 有 deadline 的行程的 miss 數量與 tardiness
+struct LatencyStats {
+    LatencyHistogram waiting;
+    LatencyHistogram turnaround;
+    LatencyHistogram response;
+    DeadlineStats deadlines;
+
+    void record(const ProcessTable& processes, size_t i);
+    void merge(const LatencyStats& other);
+    void save(SnapshotWriter& out) const;
+    void load(SnapshotReader& in);
+};
+
+// 輸出 mean / p50 / p90 / p99 / p99.9 / max，有 deadline 的行程時另外輸出 miss rate 與 tardiness 的分布
+void print_latency_stats(const LatencyStats& stats);
+
+#endif // LATENCY_STATS_H
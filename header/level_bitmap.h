@@ -0,0 +1,66 @@
+#ifndef LEVEL_BITMAP_H
+#define LEVEL_BITMAP_H
+
+#include <vector>
+#include <algorithm>
+
+// 記錄哪些優先級佇列非空的 bitmap
+// first_set() 用 find-first-set 指令找出最高優先級 (編號最小) 的非空佇列，
+// 每 64 個 level 只需要檢查一個 word
+class LevelBitmap {
+public:
+    explicit LevelBitmap(int num_levels) : words((num_levels + 63) / 64, 0) {}
+
+    // 擴充到至少 num_levels 個 level，原本的 bit 保持不變
+    void resize(int num_levels) {
+        size_t num_words = (num_levels + 63) / 64;
+        if (num_words > words.size()) words.resize(num_words, 0);
+    }
+
+    void set(int level) { words[level >> 6] |= 1ULL << (level & 63); }
+    void clear(int level) { words[level >> 6] &= ~(1ULL << (level & 63)); }
+    bool test(int level) const { return (words[level >> 6] >> (level & 63)) & 1ULL; }
+
+    // 最小的非空 level，全部為空時回傳 -1
+    int first_set() const {
+        for (size_t i = 0; i < words.size(); i++) {
+            if (words[i] != 0) {
+                return static_cast<int>(i * 64) + __builtin_ctzll(words[i]);
+            }
+        }
+        return -1;
+    }
+
+private:
+    std::vector<unsigned long long> words;
+};
+
+// priority 值 -> 緊密的層級編號 (依 priority 值排序，層級 0 是出現過的最小 priority，也就是最高優先)
+// 只記錄出現過的 priority，層級的數量是不同 priority 的數量，與 priority 值的大小無關
+// 新的 priority 插在中間時，之後的層級編號都會加一，以層級為索引的資料需要跟著往後移
+class PriorityLevels {
+public:
+    // priority 的層級，第一次出現時加入並把 inserted 設為 true
+    int add(int priority, bool& inserted) {
+        auto it = std::lower_bound(values.begin(), values.end(), priority);
+        inserted = it == values.end() || *it != priority;
+        int level = static_cast<int>(it - values.begin());
+        if (inserted) values.insert(it, priority);
+        return level;
+    }
+    // 已經加入過的 priority 的層級
+    int find(int priority) const {
+        return static_cast<int>(std::lower_bound(values.begin(), values.end(), priority) - values.begin());
+    }
+    int priority(int level) const { return values[level]; }
+    int size() const { return static_cast<int>(values.size()); }
+
+    // 給 snapshot 使用 (依大小排序的 priority 值)
+    const std::vector<int>& priorities() const { return values; }
+    void assign(const std::vector<int>& sorted_priorities) { values = sorted_priorities; }
+
+private:
+    std::vector<int> values; // 排序過、不重複
+};
+
+#endif // LEVEL_BITMAP_H
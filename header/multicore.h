@@ -0,0 +1,65 @@
+#ifndef MULTICORE_H
+#define MULTICORE_H
+
+#include "process.h"
+#include "event_sim.h"
+#include "latency_stats.h"
+#include "replay.h"
+#include <vector>
+#include <string>
+
+// 多核心模擬：N 個核心，每個核心有自己的 EventSimulator (slot 行程表、事件、I/O、context switch 成本) 與
+// 單一 CPU 的排程引擎 (policy_engine.h 的 PolicyEngine 搭配 ready_queues.h 的就緒佇列)，
+// 跨核心的部分只有 load balancing：新行程放到哪個核心、空閒的核心從哪個核心偷行程
+// 移到其他核心的行程像新到達的行程一樣進入那個核心的就緒佇列 (MLFQ 回到最高層、CFS 從該核心的 min_vruntime 開始)，
+// 而且 cache 是冷的
+
+enum LoadBalancing {
+    BALANCE_GLOBAL,        // 與共用一個 run queue 相同，有行程在等待時不會有核心空閒 (見 run_multicore)
+    BALANCE_WORK_STEALING, // 新行程輪流分配到各核心，空閒的核心從等待行程最多的核心偷一個
+    BALANCE_AFFINITY       // 新行程放到負載最輕的核心，被搶佔後留在原核心，差距夠大才偷
+};
+
+struct MultiCoreConfig {
+    int num_cores;
+    LoadBalancing balancing;
+    std::string policy;          // 每個核心的排程方式：sjf|rr|mlfq|custom|cfs|edf|edf-hybrid (與 scheduler_by_name 相同)
+    SchedulerParams params;      // policy 的參數
+    SwitchCostModel switch_cost; // 每個核心各自計算 context switch 與 cache 暖機的成本
+    int steal_threshold;         // BALANCE_AFFINITY：victim 至少要有這麼多行程在等待才偷
+    int num_threads;             // 把核心分給幾個 host thread 平行模擬，結果與 1 (循序) 完全相同
+};
+
+MultiCoreConfig default_multicore_config(int num_cores);
+bool is_multicore_policy(const std::string& policy);
+
+struct CoreStats {
+    SimTime busy_time;
+    SimTime switch_time;     // context switch 與 cache 暖機花的時間 (不算在 busy_time)
+    long long dispatches;
+    long long context_switches;
+    long long migrations_in; // 在其他核心執行過、移到這個核心的次數
+    long long steals;        // 從其他核心偷來的次數
+};
+
+struct MultiCoreResult {
+    std::vector<CoreStats> cores;
+    long long completed_processes;
+    long long context_switches;
+    long long migrations;
+    SimTime makespan;
+    LatencyStats latency;
+};
+
+// 依 arrival 順序從 source 取得行程，記憶體只跟同時存在的行程數量有關
+// 現有的就緒佇列都假設只有一個執行中的行程 (例如 CFS 的 current)，不能由多個核心共用，
+// 所以 BALANCE_GLOBAL 也是每個核心一個佇列：新行程放到負載最輕的核心，空閒的核心只要有任何核心有行程在等待就偷過來
+// (相當於 steal threshold 為 1 的 BALANCE_AFFINITY)
+// num_threads > 1 時核心分成連續的 shard，各 shard 在保守的時間窗口內平行推進，
+// 窗口的結尾是最早可能發生跨核心互動 (偷行程、依負載分配新行程) 的時間，結果與 num_threads = 1 完全相同
+MultiCoreResult run_multicore(ArrivalSource& source, const MultiCoreConfig& config);
+
+const char* load_balancing_name(LoadBalancing balancing);
+void print_multicore_result(const MultiCoreResult& result, const MultiCoreConfig& config);
+
+#endif // MULTICORE_H
@@ -0,0 +1,275 @@
+#ifndef OUTPUT_PIPELINE_H
+#define OUTPUT_PIPELINE_H
+
+#include "gantt.h"
+#include "spsc_queue.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdio>
+
+// 呼叫端填好 block 交給背景 thread 處理 (consume)，處理完的 block 再還給呼叫端重複使用
+// 兩個方向都是 lock-free 的 SPSC queue；只有 queue 空 (背景 thread) 或滿 (呼叫端) 時才在
+// condition variable 上等待，所以背景 thread 閒置時不會空轉，呼叫端也不會忙等
+// 只能由一個 thread submit
+template <typename Block>
+class BlockPipeline {
+public:
+    explicit BlockPipeline(size_t capacity) : full_blocks(capacity), free_blocks(capacity), closing(false) {}
+    ~BlockPipeline() { finish(); }
+
+    BlockPipeline(const BlockPipeline&) = delete;
+    BlockPipeline& operator=(const BlockPipeline&) = delete;
+
+    // 啟動背景 thread，consume(Block&) 在背景 thread 上處理每個 block
+    template <typename Consume> void start(Consume consume) {
+        closing = false;
+        worker = std::thread([this, consume]() mutable { run(consume); });
+    }
+
+    // 把 block 交給背景 thread，換回一個用過的 block (已清空，保留容量)，沒有時是空的 Block
+    void submit(Block& block) {
+        if (!full_blocks.try_push(std::move(block))) {
+            std::unique_lock<std::mutex> lock(mutex);
+            space.wait(lock, [this] { return !full_blocks.full(); }); // 背景 thread 跟不上，等它處理完一個 block
+            lock.unlock();
+            full_blocks.try_push(std::move(block));
+        }
+        wake(ready);
+        if (!free_blocks.try_pop(block)) block = Block();
+    }
+
+    // 等背景 thread 處理完所有 block 後結束
+    void finish() {
+        if (!worker.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closing = true;
+        }
+        ready.notify_one();
+        worker.join();
+    }
+
+private:
+    template <typename Consume> void run(Consume& consume) {
+        Block block;
+        while (true) {
+            if (full_blocks.try_pop(block)) {
+                wake(space);
+                consume(block);
+                block.clear();
+                free_blocks.try_push(std::move(block)); // 已滿時直接丟掉
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this] { return !full_blocks.empty() || closing; });
+            // closing 在最後一個 block 放進 queue 之後才設定，所以 queue 是空的就代表全部處理完了
+            if (full_blocks.empty()) break;
+        }
+    }
+
+    // 先取得再放開 mutex：對方若正在檢查條件，會在 wait 之後才收到通知，不會漏掉
+    void wake(std::condition_variable& condition) {
+        { std::lock_guard<std::mutex> lock(mutex); }
+        condition.notify_one();
+    }
+
+    SpscQueue<Block> full_blocks; // 呼叫端 -> 背景 thread
+    SpscQueue<Block> free_blocks; // 背景 thread -> 呼叫端
+    std::mutex mutex;
+    std::condition_variable ready; // full_blocks 有資料或 closing
+    std::condition_variable space; // full_blocks 有空位
+    bool closing;                  // 由 mutex 保護
+    std::thread worker;
+};
+
+// 由背景 thread 寫入的檔案 (或 stdout)，記錄是否有寫入失敗
+class OutputFile {
+public:
+    OutputFile() : file(nullptr), owns_file(false), failed(false) {}
+
+    bool open(const std::string& filename);
+    // 寫到 stdout：期間不要使用 cout，close() 之後輸出的順序與直接寫入相同
+    void open_stdout();
+    bool is_open() const { return file != nullptr; }
+    void write(const char* data, size_t size) {
+        if (std::fwrite(data, 1, size, file) != size) failed = true;
+    }
+    bool close(); // 全部寫入成功時回傳 true
+
+private:
+    std::FILE* file;
+    bool owns_file; // stdout 不需要 fclose
+    std::atomic<bool> failed;
+};
+
+// 不經過 iostream / locale 的整數格式化；width > 0 時靠右對齊補空白 (與 setw 相同)
+inline void append_int(std::string& out, long long value, int width = 0) {
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* p = end;
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    do {
+        *--p = char('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) *--p = '-';
+    if (width > int(end - p)) out.append(width - int(end - p), ' ');
+    out.append(p, end - p);
+}
+
+// 非同步的緩衝輸出：呼叫端把資料格式化到 1MB 的 block，block 滿了才交給背景的 writer thread 寫檔
+// 所以模擬 (產生資料) 與 I/O 可以同時進行；queue 滿時呼叫端會等 writer (有上限的記憶體用量)
+// 只能由一個 thread 寫入
+class AsyncFileWriter {
+public:
+    AsyncFileWriter() : pipeline(QUEUE_BLOCKS) {}
+    ~AsyncFileWriter(); // 尚未 close() 時自動 close()
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    bool open(const std::string& filename); // 開檔並啟動 writer thread
+    void open_stdout();                      // 見 OutputFile::open_stdout
+    bool is_open() const { return file.is_open(); }
+
+    void write(const char* data, size_t size) {
+        if (block.size() + size > BLOCK_SIZE) flush_block();
+        block.append(data, size);
+    }
+    void write(const std::string& text) { write(text.data(), text.size()); }
+    void put(char c) {
+        if (block.size() >= BLOCK_SIZE) flush_block();
+        block.push_back(c);
+    }
+    void write_int(long long value, int width = 0) {
+        if (block.size() + 24 + width > BLOCK_SIZE) flush_block();
+        append_int(block, value, width);
+    }
+
+    // 送出剩下的資料並等 writer thread 寫完，全部寫入成功時回傳 true
+    bool close();
+
+private:
+    static const size_t BLOCK_SIZE = 1 << 20;
+    static const size_t QUEUE_BLOCKS = 8; // 最多 8 個 block 在等待寫入
+
+    void start();
+    void flush_block();
+
+    OutputFile file;
+    std::string block; // 正在填的 block
+    BlockPipeline<std::string> pipeline;
+};
+
+// 非同步的記錄輸出：呼叫端只把原始的記錄 (甘特圖區間、結果表的一列等) 複製到 block，
+// 格式化與寫檔都在背景 thread 進行，模擬的 thread 不需要負擔格式化的成本
+// Format 是 void operator()(const Record&, std::string& out) const，把一筆記錄接在 out 後面
+// 只能由一個 thread 寫入
+template <typename Record, typename Format>
+class AsyncRecordWriter {
+public:
+    AsyncRecordWriter() : pipeline(QUEUE_BLOCKS) {}
+    ~AsyncRecordWriter() {
+        if (is_open()) close();
+    }
+
+    AsyncRecordWriter(const AsyncRecordWriter&) = delete;
+    AsyncRecordWriter& operator=(const AsyncRecordWriter&) = delete;
+
+    // header 在任何記錄之前寫入 (例如 CSV 標頭)
+    bool open(const std::string& filename, const std::string& header = std::string()) {
+        if (is_open()) close();
+        if (!file.open(filename)) return false;
+        file.write(header.data(), header.size());
+        start();
+        return true;
+    }
+    void open_stdout() {
+        if (is_open()) close();
+        file.open_stdout();
+        start();
+    }
+    bool is_open() const { return file.is_open(); }
+
+    void write(const Record& record) {
+        block.push_back(record);
+        if (block.size() >= BLOCK_RECORDS) flush_block();
+    }
+
+    // 送出剩下的記錄並等 writer thread 寫完，全部寫入成功時回傳 true
+    bool close() {
+        if (!is_open()) return false;
+        flush_block();
+        pipeline.finish();
+        return file.close();
+    }
+
+private:
+    static const size_t BLOCK_RECORDS = 1 << 14;
+    static const size_t QUEUE_BLOCKS = 8;
+    static const size_t TEXT_FLUSH_SIZE = 1 << 20;
+
+    void start() {
+        block.reserve(BLOCK_RECORDS);
+        pipeline.start([this](std::vector<Record>& records) {
+            // 只有背景 thread 使用 text
+            for (const Record& record : records) {
+                Format()(record, text);
+                if (text.size() >= TEXT_FLUSH_SIZE) {
+                    file.write(text.data(), text.size());
+                    text.clear();
+                }
+            }
+            file.write(text.data(), text.size());
+            text.clear();
+        });
+    }
+
+    void flush_block() {
+        if (block.empty()) return;
+        pipeline.submit(block);
+        block.reserve(BLOCK_RECORDS);
+    }
+
+    OutputFile file;
+    std::vector<Record> block; // 正在填的 block
+    std::string text;          // 背景 thread 格式化用的 buffer
+    BlockPipeline<std::vector<Record>> pipeline;
+};
+
+// 甘特圖區間的 CSV 格式 (Start,End,ProcessID)
+struct GanttCsvFormat {
+    void operator()(const GanttSegment& segment, std::string& out) const {
+        append_int(out, segment.start);
+        out.push_back(',');
+        append_int(out, segment.end);
+        out.push_back(',');
+        append_int(out, segment.process_id);
+        out.push_back('\n');
+    }
+};
+
+// 甘特圖 CSV (Start,End,ProcessID)：可以當作 GanttTimeline 的 sink，
+// 讓模擬在產生區間的同時由背景 thread 格式化並寫檔，整條甘特圖不需要留在記憶體中
+class GanttCsvWriter : public GanttSink {
+public:
+    // 無法開檔時輸出錯誤訊息，is_open() 為 false
+    explicit GanttCsvWriter(const std::string& filename);
+
+    bool is_open() const { return output.is_open(); }
+    GanttSink* sink() { return is_open() ? this : nullptr; }
+
+    void write_segment(const GanttSegment& segment) override { output.write(segment); }
+
+    void close(); // 寫完後輸出 "Gantt chart data saved to ..."
+
+private:
+    std::string filename;
+    AsyncRecordWriter<GanttSegment, GanttCsvFormat> output;
+};
+
+#endif // OUTPUT_PIPELINE_H
@@ -0,0 +1,475 @@
+#ifndef POLICY_ENGINE_H
+#define POLICY_ENGINE_H
+
+#include "process.h"
+#include "scheduling.h"
+#include "event_sim.h"
+#include "telemetry.h"
+#include "level_bitmap.h"
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <climits>
+
+// policy-based 排程引擎：事件處理、admit、搶佔、dispatch、time quantum 與推進時間只寫一次，
+// 演算法之間不同的部分由三個 policy 提供，在編譯時期組合 (template，不經過 virtual call)
+//
+// ReadyQueue (見 ready_queues.h)
+//   static constexpr bool preemptive;  新 ready 的行程是否可以搶佔執行中的行程
+//                                      (false 時只在 quantum 結束或完成時重新選擇)
+//   void admit(int idx);               新到達 (或被 aging 重新 admit) 的行程進入佇列
+//   bool empty(); int top(); void pop();
+//   void requeue_expired(int idx);     quantum 用完的行程放回佇列
+//   void on_complete(int idx);         行程完成 (slot 之後會被重複使用)
+//   void block(int idx);               執行中的行程的 CPU burst 結束，開始做 I/O
+//   void wake(int idx);                I/O 結束，行程帶著下一個 CPU burst 回到佇列
+//   int take();                        取出最前面等待中的行程交給其他 CPU (多核心模擬偷行程)，之後不會再收到這個行程的通知
+//   void save(SnapshotWriter&) const;  checkpoint：寫出佇列的狀態
+//   void load(SnapshotReader&);        resume：在還原好的模擬器上重建佇列 (建構時的設定可以與保存時不同)
+//   preemptive 時另外需要：
+//   bool preempts(int candidate, int running) const;
+//   void requeue_preempted(int idx);   被搶佔的行程放回佇列 (non-preemptive 但 AgingPolicy::timed 時也需要)
+//
+// QuantumPolicy
+//   static constexpr bool bounded;     false 表示一律執行到完成 (不會有 quantum expiry)
+//   SimTime slice(const ReadyQueue& queue, int idx, SimTime remaining) const;
+//                                      行程 dispatch 時可以執行多久，可以查詢 queue 的狀態
+//
+// AgingPolicy (避免 starvation)
+//   on_ready(sim, queue, idx)          行程進入佇列之後
+//   on_dispatch(sim, queue, idx)       行程從佇列被選出之後
+//   on_event(sim, queue, event)        EVENT_AGING
+//   before_admission(sim, queue)       每一輪處理完事件、admit 新行程之前
+//   static constexpr bool timed;       true 時另外需要 SimTime next_wakeup() const：下一次 before_admission
+//                                      需要執行的時間 (-1 表示沒有)，執行中的 slice 在這個時間被中斷
+//   save(out) / load(sim, queue, in)   checkpoint / resume (參數改變時從 resume 的時間點開始套用)
+
+// ---- quantum policies ----
+
+struct RunToCompletion {
+    static constexpr bool bounded = false;
+    template <typename Queue> SimTime slice(const Queue&, int, SimTime remaining) const { return remaining; }
+};
+
+struct FixedQuantum {
+    static constexpr bool bounded = true;
+    SimTime quantum;
+    template <typename Queue> SimTime slice(const Queue&, int, SimTime) const { return quantum; }
+};
+
+// 每一層各自的 quantum (MLFQConfig)，POLICY_FCFS 的層執行到完成，需要 Queue::level(idx)
+struct LevelQuantum {
+    static constexpr bool bounded = true;
+    const MLFQConfig& config;
+    template <typename Queue> SimTime slice(const Queue& queue, int idx, SimTime remaining) const {
+        const MLFQLevel& level_config = config.levels[queue.level(idx)];
+        return level_config.policy == POLICY_FCFS ? remaining : level_config.quantum;
+    }
+};
+
+// CFS 的 time slice：target_latency 依 weight 比例分給所有可執行的行程 (含執行中的行程)，
+// 行程多到每個分不到 min_granularity 時把週期拉長為 可執行數量 x min_granularity，
+// 每次至少執行 min_granularity；需要 Queue::weight(idx) / total_weight() / runnable_count()
+struct FairSlice {
+    static constexpr bool bounded = true;
+    const CFSConfig& config;
+    template <typename Queue> SimTime slice(const Queue& queue, int idx, SimTime) const {
+        SimTime period = std::max<SimTime>(config.target_latency, queue.runnable_count() * config.min_granularity);
+        return std::max<SimTime>(config.min_granularity, period * queue.weight(idx) / queue.total_weight());
+    }
+};
+
+// ---- aging policies ----
+
+struct NoAging {
+    static constexpr bool timed = false;
+    template <typename Queue> void on_ready(EventSimulator&, Queue&, int) {}
+    template <typename Queue> void on_dispatch(EventSimulator&, Queue&, int) {}
+    template <typename Queue> void on_event(EventSimulator&, Queue&, const Event&) {}
+    template <typename Queue> void before_admission(EventSimulator&, Queue&) {}
+    void save(SnapshotWriter&) const {}
+    template <typename Queue> void load(EventSimulator&, Queue&, SnapshotReader&) {}
+};
+
+// 定期把所有等待中的行程移回最高層 (MLFQ priority boost)，需要 Queue::boost()
+// boost 的時間是 timed wakeup：執行中的行程 (例如最低層的 FCFS) 在 boost 時被中斷並一起移回最高層，
+// 所以等待中的行程最多等一個 interval 就會回到最高層
+class PeriodicBoost : public NoAging {
+public:
+    static constexpr bool timed = true;
+
+    explicit PeriodicBoost(SimTime interval) : interval(interval), next_boost_time(interval) {}
+
+    SimTime next_wakeup() const { return interval > 0 ? next_boost_time : -1; }
+
+    template <typename Queue> void before_admission(EventSimulator& sim, Queue& queue) {
+        if (interval > 0 && sim.now() >= next_boost_time) {
+            queue.boost();
+            next_boost_time = (sim.now() / interval + 1) * interval;
+        }
+    }
+
+    void save(SnapshotWriter& out) const {
+        out.put(interval);
+        out.put(next_boost_time);
+    }
+    // interval 改變時下一次 boost 改為新 interval 在 resume 之後的第一個倍數
+    template <typename Queue> void load(EventSimulator& sim, Queue&, SnapshotReader& in) {
+        SimTime saved_interval = 0;
+        SimTime saved_next = 0;
+        in.get(saved_interval);
+        in.get(saved_next);
+        if (saved_interval == interval) {
+            next_boost_time = saved_next;
+        } else if (interval > 0) {
+            next_boost_time = (sim.now() / interval + 1) * interval;
+        }
+    }
+
+private:
+    SimTime interval; // 0 表示不 boost
+    SimTime next_boost_time;
+};
+
+// 在同一個 priority 等待超過 threshold 的行程提升 priority (AgingConfig)
+// 需要 Queue::rank(idx) / is_waiting(idx) / remove(idx)：每次進入佇列都會拿到新的 rank
+// aging 是 lazy 的：每個 priority 只替最舊的行程排一個 aging 事件，
+// 到期時才把超過 threshold 的行程往上一個 priority 搬，不需要每次都掃過所有等待中的行程
+// 每個出現過的 priority 一個 bucket (PriorityLevels)，與 priority 值的大小無關
+class ThresholdAging {
+public:
+    static constexpr bool timed = false; // aging 由 EVENT_AGING 觸發
+
+    explicit ThresholdAging(const AgingConfig& config) : config(config) {}
+
+    template <typename Queue> void on_ready(EventSimulator& sim, Queue& queue, int idx) {
+        ProcessTable& processes = sim.get_processes();
+        bool inserted = false;
+        int bucket = buckets.add(processes.priority[idx], inserted);
+        if (inserted) {
+            waiters.insert(waiters.begin() + bucket, std::deque<WaitEntry>());
+            armed_rank.insert(armed_rank.begin() + bucket, LLONG_MIN);
+        }
+        processes.last_run_time[idx] = sim.now(); // 等待起點 for aging calculation
+        waiters[bucket].push_back(WaitEntry{idx, queue.rank(idx)});
+        arm(sim, queue, bucket);
+    }
+
+    template <typename Queue> void on_dispatch(EventSimulator& sim, Queue& queue, int idx) {
+        sim.cancel_events(idx); // 執行中的行程不會 aging
+        arm(sim, queue, buckets.find(sim.get_processes().priority[idx]));
+    }
+
+    // 取出這個 priority 中所有已等待超過 threshold 的行程
+    template <typename Queue> void on_event(EventSimulator& sim, Queue& queue, const Event& e) {
+        ProcessTable& processes = sim.get_processes();
+        int bucket = buckets.find(processes.priority[e.proc_idx]);
+        std::deque<WaitEntry>& bucket_waiters = waiters[bucket];
+        while (!bucket_waiters.empty()) {
+            const WaitEntry& front = bucket_waiters.front();
+            if (is_live(queue, front)) {
+                if (sim.now() - processes.last_run_time[front.idx] < config.threshold) break;
+                aged.push_back(front.idx);
+                queue.remove(front.idx);
+            }
+            bucket_waiters.pop_front();
+        }
+        armed_rank[bucket] = LLONG_MIN;
+        arm(sim, queue, bucket);
+    }
+
+    // 提升 priority 後依原本的順序重新 admit (重置等待起點，避免立即再次 aging)
+    template <typename Queue> void before_admission(EventSimulator& sim, Queue& queue) {
+        if (aged.empty()) return;
+        ProcessTable& processes = sim.get_processes();
+        std::sort(aged.begin(), aged.end(), [&](int a_idx, int b_idx) {
+            if (processes.priority[a_idx] != processes.priority[b_idx]) {
+                return processes.priority[a_idx] < processes.priority[b_idx];
+            }
+            if (processes.remaining_burst_time[a_idx] != processes.remaining_burst_time[b_idx]) {
+                return processes.remaining_burst_time[a_idx] < processes.remaining_burst_time[b_idx];
+            }
+            return queue.rank(a_idx) < queue.rank(b_idx);
+        });
+        for (int idx : aged) {
+            processes.priority[idx] = std::max(1, processes.priority[idx] - config.priority_boost);
+            queue.admit(idx);
+            on_ready(sim, queue, idx);
+        }
+        aged.clear();
+    }
+
+    void save(SnapshotWriter& out) const {
+        out.put(config.threshold);
+        out.put(buckets.priorities());
+        out.put<std::uint64_t>(waiters.size());
+        for (const auto& bucket_waiters : waiters) out.put(bucket_waiters);
+        out.put(armed_rank);
+        out.put(aged);
+    }
+    // threshold 改變時已排定的 aging 事件時間不對：取消後依新的 threshold 重新排
+    template <typename Queue> void load(EventSimulator& sim, Queue& queue, SnapshotReader& in) {
+        SimTime saved_threshold = 0;
+        std::vector<int> priorities;
+        std::uint64_t num_buckets = 0;
+        in.get(saved_threshold);
+        in.get(priorities);
+        in.get(num_buckets);
+        buckets.assign(priorities);
+        waiters.clear();
+        for (std::uint64_t bucket = 0; bucket < num_buckets && !in.failed(); bucket++) {
+            waiters.emplace_back();
+            in.get(waiters.back());
+        }
+        in.get(armed_rank);
+        in.get(aged);
+        if (in.failed() || armed_rank.size() != waiters.size() || (int)waiters.size() != buckets.size()) return;
+        if (saved_threshold != config.threshold) {
+            for (int bucket = 0; bucket < (int)waiters.size(); bucket++) {
+                if (armed_rank[bucket] == LLONG_MIN) continue;
+                for (const WaitEntry& entry : waiters[bucket]) {
+                    if (entry.rank == armed_rank[bucket]) sim.cancel_events(entry.idx);
+                }
+                armed_rank[bucket] = LLONG_MIN;
+                arm(sim, queue, bucket);
+            }
+        }
+    }
+
+private:
+    struct WaitEntry {
+        int idx;
+        long long rank;
+    };
+
+    template <typename Queue> static bool is_live(const Queue& queue, const WaitEntry& entry) {
+        return queue.is_waiting(entry.idx) && queue.rank(entry.idx) == entry.rank;
+    }
+
+    // 替 bucket 中最舊的行程排定 aging 事件 (priority 1 不需要 aging)
+    template <typename Queue> void arm(EventSimulator& sim, const Queue& queue, int bucket) {
+        if (buckets.priority(bucket) <= 1) return;
+        std::deque<WaitEntry>& bucket_waiters = waiters[bucket];
+        while (!bucket_waiters.empty() && !is_live(queue, bucket_waiters.front())) {
+            bucket_waiters.pop_front();
+        }
+        if (!bucket_waiters.empty() && armed_rank[bucket] != bucket_waiters.front().rank) {
+            int idx = bucket_waiters.front().idx;
+            sim.schedule(sim.get_processes().last_run_time[idx] + config.threshold, EVENT_AGING, idx);
+            armed_rank[bucket] = bucket_waiters.front().rank;
+        }
+    }
+
+    AgingConfig config;
+    PriorityLevels buckets;
+    std::vector<std::deque<WaitEntry>> waiters; // 每個 priority 依等待起點排序的 FIFO，最前面就是最舊的行程
+    std::vector<long long> armed_rank;          // 已排 aging 事件的項目
+    std::vector<int> aged;                      // 這一輪到期的行程
+};
+
+// ---- engine ----
+
+// 只有 preemptive 的 ReadyQueue 需要提供 preempts() / requeue_preempted()
+template <bool Preemptive>
+struct PreemptionHooks {
+    template <typename Queue> static bool preempts(const Queue& queue, int candidate, int running) {
+        return queue.preempts(candidate, running);
+    }
+    template <typename Queue> static void requeue(Queue& queue, int idx) { queue.requeue_preempted(idx); }
+};
+
+template <>
+struct PreemptionHooks<false> {
+    template <typename Queue> static bool preempts(const Queue&, int, int) { return false; }
+    template <typename Queue> static void requeue(Queue&, int) {}
+};
+
+// 只有 timed 的 AgingPolicy 需要提供 next_wakeup()，non-preemptive 的 ReadyQueue 也才需要 requeue_preempted()
+template <bool Timed>
+struct WakeupHooks {
+    template <typename Aging> static SimTime next(const Aging& aging) { return aging.next_wakeup(); }
+    template <typename Queue> static void requeue(Queue& queue, int idx) { queue.requeue_preempted(idx); }
+};
+
+template <>
+struct WakeupHooks<false> {
+    template <typename Aging> static SimTime next(const Aging&) { return -1; }
+    template <typename Queue> static void requeue(Queue&, int) {}
+};
+
+// 引擎的一輪一輪推進：run_policy_engine 的迴圈就是
+//   while (engine.round()) engine.advance(engine.next_round());
+// 多核心模擬 (multicore.h) 以同樣的方式推進每個核心，只是把 advance 切在各核心之間同步的時間點
+template <typename ReadyQueue, typename QuantumPolicy, typename AgingPolicy>
+class PolicyEngine {
+public:
+    PolicyEngine(EventSimulator& sim, ReadyQueue& ready, const QuantumPolicy& quantum, AgingPolicy& aging)
+        : sim(sim), ready(ready), quantum(quantum), aging(aging), processes(sim.get_processes()), running_idx(-1) {}
+
+    // 從 checkpoint 繼續 (模擬器已經還原，接著依保存的順序還原引擎、佇列與 aging 的狀態)，失敗時回傳 false
+    bool resume() {
+        if (sim.resume_failed()) return false;
+        if (SnapshotReader* state = sim.resume_state()) {
+            state->get(running_idx);
+            ready.load(*state);
+            aging.load(sim, ready, *state);
+            return sim.finish_resume();
+        }
+        return true;
+    }
+
+    // 處理現在到期的事件、admit 已到達的行程並選擇要執行的行程 (可能搶佔)，所有行程都完成時回傳 false
+    bool round() {
+        if (sim.done()) return false;
+        if (sim.checkpoint_due()) {
+            SnapshotWriter state;
+            sim.save(state);
+            state.put(running_idx);
+            ready.save(state);
+            aging.save(state);
+            sim.write_checkpoint(state);
+        }
+        TELEMETRY_PHASE(sim, TELEMETRY_BOOKKEEPING);
+        // 處理現在到期的事件
+        while (sim.has_event_due()) {
+            handle_event(sim.pop_event());
+        }
+        aging.before_admission(sim, ready);
+
+        // 將所有已到達的行程加入就緒佇列 (每個行程只會被 admit 一次)
+        while (sim.has_arrival_due()) {
+            int idx = sim.pop_arrival();
+            ready.admit(idx);
+            aging.on_ready(sim, ready, idx);
+        }
+        if (sim.done()) return false;
+
+        TELEMETRY_PHASE(sim, TELEMETRY_SELECTION);
+        if (!ready.empty()) {
+            int best_idx = ready.top();
+            if (running_idx == -1 || Preemption::preempts(ready, best_idx, running_idx)) {
+                ready.pop();
+                aging.on_dispatch(sim, ready, best_idx);
+                if (running_idx != -1) {
+                    TELEMETRY_PREEMPTION(sim);
+                    sim.cancel_events(running_idx);
+                    Preemption::requeue(ready, running_idx);
+                    aging.on_ready(sim, ready, running_idx);
+                }
+                running_idx = best_idx;
+                SimTime start = sim.now() + sim.dispatch(running_idx); // 先付完 context switch 的成本
+
+                // 執行一個 time quantum 或直到這個 CPU burst 結束
+                SimTime remaining = processes.remaining_burst_time[running_idx];
+                SimTime slice = QuantumPolicy::bounded ? quantum.slice(ready, running_idx, remaining) : remaining;
+                if (remaining <= slice) {
+                    sim.schedule(start + remaining, EVENT_COMPLETION, running_idx);
+                } else {
+                    sim.schedule(start + slice, EVENT_QUANTUM_EXPIRY, running_idx);
+                }
+            }
+        }
+        TELEMETRY_PHASE(sim, TELEMETRY_BOOKKEEPING);
+        return true;
+    }
+
+    // 下一次需要 round() 的時間，-1 表示沒有任何事件
+    SimTime next_round() {
+        if (running_idx == -1) return sim.next_event_time(); // CPU 空閒，直接跳到下一個事件
+        SimTime wakeup = Wakeup::next(aging); // 例如下一次 priority boost
+        if (ReadyQueue::preemptive) {
+            SimTime end_time = sim.next_event_time(); // 下一個 arrival 可能搶佔
+            return wakeup != -1 && wakeup < end_time ? wakeup : end_time;
+        }
+        // quantum 內不會被搶佔，期間到達的行程在下一輪才 admit
+        SimTime peek = sim.peek_event_time();
+        return wakeup != -1 && (peek == -1 || wakeup < peek) ? wakeup : peek;
+    }
+
+    // CPU 執行 (或空閒) 到 end，end 不超過 next_round()
+    // 到達 next_round() 時，non-preemptive 的 slice 在這裡結束 (處理結束 slice 的事件，或在 wakeup 時中斷)
+    void advance(SimTime end) {
+        if (running_idx == -1) {
+            sim.idle_until(end); // 佇列是空的，wakeup 不需要中斷
+            return;
+        }
+        if (ReadyQueue::preemptive) {
+            sim.run_until(running_idx, end);
+            return;
+        }
+        SimTime wakeup = Wakeup::next(aging);
+        SimTime peek = sim.peek_event_time();
+        sim.run_until(running_idx, end);
+        if (wakeup != -1 && (peek == -1 || wakeup < peek)) {
+            if (end < wakeup) return;
+            // slice 在 wakeup 時中斷：執行中的行程放回原本的層 (沒有用完 quantum，不降級)，
+            // 下一輪由 before_admission 處理 (例如 boost 回最高層)
+            TELEMETRY_PREEMPTION(sim);
+            sim.cancel_events(running_idx);
+            Wakeup::requeue(ready, running_idx);
+            aging.on_ready(sim, ready, running_idx);
+            running_idx = -1;
+        } else if (end == peek) {
+            handle_event(sim.pop_event());
+        }
+    }
+
+    bool idle() const { return running_idx == -1; }
+
+    // 取出佇列最前面等待中的行程交給其他 CPU (多核心模擬偷行程)，佇列是空的時回傳 -1
+    // 行程從此不屬於這個佇列，呼叫者複製 slot 的內容後以 EventSimulator::release 釋放
+    int steal() {
+        if (ready.empty()) return -1;
+        int idx = ready.take();
+        aging.on_dispatch(sim, ready, idx); // 與被選出執行相同，不會再 aging
+        return idx;
+    }
+
+private:
+    typedef PreemptionHooks<ReadyQueue::preemptive> Preemption;
+    typedef WakeupHooks<AgingPolicy::timed> Wakeup;
+
+    void handle_event(const Event& e) {
+        if (e.type == EVENT_COMPLETION) {
+            if (sim.last_burst(e.proc_idx)) {
+                ready.on_complete(e.proc_idx);
+                sim.complete(e.proc_idx);
+            } else {
+                ready.block(e.proc_idx);
+                sim.start_io(e.proc_idx);
+            }
+            running_idx = -1;
+        } else if (e.type == EVENT_IO_COMPLETION) {
+            sim.finish_io(e.proc_idx);
+            ready.wake(e.proc_idx);
+            aging.on_ready(sim, ready, e.proc_idx);
+        } else if (e.type == EVENT_QUANTUM_EXPIRY) {
+            TELEMETRY_PREEMPTION(sim);
+            ready.requeue_expired(e.proc_idx);
+            aging.on_ready(sim, ready, e.proc_idx);
+            running_idx = -1;
+        } else {
+            aging.on_event(sim, ready, e);
+        }
+    }
+
+    EventSimulator& sim;
+    ReadyQueue& ready;
+    const QuantumPolicy& quantum;
+    AgingPolicy& aging;
+    ProcessTable& processes; // 依 slot 索引存放已到達的行程 (struct-of-arrays)
+    int running_idx;         // 執行中的行程索引，-1 表示CPU空閒
+};
+
+template <typename ReadyQueue, typename QuantumPolicy, typename AgingPolicy>
+void run_policy_engine(EventSimulator& sim, ReadyQueue& ready, const QuantumPolicy& quantum, AgingPolicy& aging) {
+    PolicyEngine<ReadyQueue, QuantumPolicy, AgingPolicy> engine(sim, ready, quantum, aging);
+    if (engine.resume()) {
+        while (engine.round()) {
+            engine.advance(engine.next_round());
+        }
+    }
+    TELEMETRY_PHASE(sim, TELEMETRY_NONE);
+}
+
+#endif // POLICY_ENGINE_H
@@ -1,26 +1,72 @@
-#ifndef PROCESS_H
-#define PROCESS_H
-
-#include <vector>
-#include <string>
-
-struct Process {
-    int id;
-    int arrival_time;  // (ms)
-    int burst_time;    // (ms)
-    int priority;      // (數字越小 priority 越高)
-
-    int remaining_burst_time; // 剩餘的CPU時間
-    int start_time;           // 第一次獲得CPU的時間
-    int completion_time;      // 完成執行時間
-    int last_run_time;        // 上次停止執行時的時間 (calculate waiting time, especially aging 機制)
-    bool is_started;          // 是否已經開始執行過
-
-    Process(int _id, int _arrival, int _burst, int _priority);
-    Process(const Process& other) = default;
-};
-
-// generate random process
-std::vector<Process> generate_processes(int num_processes);
-
-#endif // PROCESS_H
+#ifndef PROCESS_H
+#define PROCESS_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// 模擬時間 (ms)，使用 64-bit 避免數百萬個行程的長時間模擬溢位
+typedef std::int64_t SimTime;
+
+struct Process {
+    int id;
+    SimTime arrival_time;  // (ms)
+    SimTime burst_time;    // (ms) 所有 CPU burst 的總和
+    int priority;          // (數字越小 priority 越高)
+    SimTime deadline;      // 相對於 arrival time 的 deadline (ms)，-1 表示沒有 deadline
+    // CPU 與 I/O 交替的 burst 序列：CPU, I/O, CPU, ..., CPU (長度為奇數)
+    // 空的表示只有一個長度為 burst_time 的 CPU burst (純 CPU 的行程)
+    std::vector<SimTime> bursts;
+    SimTime io_time;       // 所有 I/O burst 的總和
+
+    SimTime remaining_burst_time; // 目前這個 CPU burst 剩餘的時間
+    SimTime start_time;           // 第一次獲得CPU的時間
+    SimTime completion_time;      // 完成執行時間
+    SimTime last_run_time;        // 上次停止執行時的時間 (calculate waiting time, especially aging 機制)
+    bool is_started;              // 是否已經開始執行過
+
+    Process(int _id, SimTime _arrival, SimTime _burst, int _priority, SimTime _deadline = -1);
+    Process(const Process& other) = default;
+
+    // 設定 burst 序列，並依此重新計算 burst_time / io_time / remaining_burst_time
+    // 只有一個 CPU burst 時存成空的序列
+    void set_bursts(const std::vector<SimTime>& sequence);
+};
+
+// struct-of-arrays 行程表：每個欄位各自連續存放
+// 排程的熱迴圈只讀 remaining_burst_time / priority 等少數欄位，不會把整筆 Process 帶進 cache
+// id 與 priority 使用較窄的整數 (priority 須在 int16 範圍內)，start_time == -1 表示尚未執行過
+struct ProcessTable {
+    std::vector<std::int32_t> id;
+    std::vector<std::int16_t> priority;
+    std::vector<SimTime> arrival_time;
+    std::vector<SimTime> burst_time;
+    std::vector<SimTime> deadline; // 相對 deadline，-1 表示沒有
+    std::vector<std::vector<SimTime>> bursts; // CPU / I/O 交替的序列，純 CPU 的行程是空的
+    std::vector<std::int32_t> burst_index;   // 目前在序列中的位置 (偶數為 CPU burst，奇數為 I/O burst)
+    std::vector<SimTime> io_time;
+    std::vector<SimTime> remaining_burst_time; // 目前這個 CPU burst 剩餘的時間
+    std::vector<SimTime> start_time;
+    std::vector<SimTime> completion_time;
+    std::vector<SimTime> last_run_time;
+    std::vector<SimTime> off_cpu_time; // 上次離開 CPU 的時間 (cache 冷卻的起點)，-1 表示還沒執行過
+
+    size_t size() const { return id.size(); }
+    bool empty() const { return id.empty(); }
+    void reserve(size_t n);
+    void resize(size_t n);
+    void clear(); // 保留容量
+
+    void push_back(const Process& p);
+    void assign(size_t i, const Process& p);        // 覆寫第 i 列
+    void assign(size_t i, const ProcessTable& other, size_t j); // 以 other 的第 j 列覆寫第 i 列
+    void append(const ProcessTable& other, size_t i); // 複製 other 的第 i 列到最後
+    Process row(size_t i) const;
+};
+
+// generate random process (作業規定的分布：arrival 0 / 5 / 10、burst 6 ~ 28、priority 1 ~ 3)
+// 相同 seed 產生相同的 workload (只限同一個標準函式庫，大量或可攜的 workload 請用 generator.h)
+std::vector<Process> generate_processes(int num_processes, unsigned int seed);
+
+#endif // PROCESS_H
@@ -0,0 +1,719 @@
+#ifndef READY_QUEUES_H
+#define READY_QUEUES_H
+
+#include "process.h"
+#include "event_sim.h"
+#include "indexed_heap.h"
+#include "level_bitmap.h"
+#include "telemetry.h"
+#include "scheduling.h"
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <set>
+#include <climits>
+
+// run_policy_engine (policy_engine.h) 使用的就緒佇列，介面見 policy_engine.h
+// 所有比較都是 inline 的 functor，搭配引擎一起在編譯時期展開
+
+// 剩餘 burst time 最短的優先 (preemptive SJF / SRTF)
+// 剩餘 burst time 相同時的順序：最近被搶佔的行程優先，其次依 admit 順序
+class ShortestRemainingQueue {
+public:
+    static constexpr bool preemptive = true;
+
+    explicit ShortestRemainingQueue(EventSimulator& sim)
+        : sim(sim), processes(sim.get_processes()), next_admit_rank(0), next_preempt_rank(0),
+          heap(0, Shorter{&processes, &tie_rank}) {}
+
+    void admit(int idx) {
+        tie_rank.resize(sim.slot_count());
+        heap.grow(sim.slot_count());
+        tie_rank[idx] = next_admit_rank++;
+        heap.push(idx);
+    }
+    bool empty() const { return heap.empty(); }
+    int top() const { return heap.top(); }
+    void pop() { heap.pop(); }
+
+    // 只有更短時才搶佔執行中的行程
+    bool preempts(int candidate, int running) const {
+        return processes.remaining_burst_time[candidate] < processes.remaining_burst_time[running];
+    }
+    void requeue_preempted(int idx) {
+        tie_rank[idx] = --next_preempt_rank;
+        heap.push(idx);
+    }
+    void requeue_expired(int idx) {
+        tie_rank[idx] = next_admit_rank++;
+        heap.push(idx);
+    }
+    void on_complete(int) {}
+    void block(int) {}
+    void wake(int idx) { requeue_expired(idx); } // 依下一個 CPU burst 的長度排序
+    int take() {
+        int idx = heap.top();
+        heap.pop();
+        return idx;
+    }
+
+    void save(SnapshotWriter& out) const {
+        out.put(tie_rank);
+        out.put(next_admit_rank);
+        out.put(next_preempt_rank);
+        out.put(heap.items());
+    }
+    void load(SnapshotReader& in) {
+        std::vector<int> items;
+        in.get(tie_rank);
+        in.get(next_admit_rank);
+        in.get(next_preempt_rank);
+        in.get(items);
+        tie_rank.resize(sim.slot_count());
+        heap.grow(sim.slot_count());
+        for (int idx : items) heap.push(idx);
+    }
+
+private:
+    struct Shorter {
+        const ProcessTable* processes;
+        const std::vector<long long>* tie_rank;
+        bool operator()(int a_idx, int b_idx) const {
+            if (processes->remaining_burst_time[a_idx] != processes->remaining_burst_time[b_idx]) {
+                return processes->remaining_burst_time[a_idx] < processes->remaining_burst_time[b_idx];
+            }
+            return (*tie_rank)[a_idx] < (*tie_rank)[b_idx];
+        }
+    };
+
+    EventSimulator& sim;
+    ProcessTable& processes;
+    std::vector<long long> tie_rank;
+    long long next_admit_rank;
+    long long next_preempt_rank;
+    // 以剩餘 burst time 為 key 的 indexed min-heap (不含執行中的行程)
+    // 等待中的行程 key 不會改變，所以每次排程決策只需要 O(log n)
+    IndexedMinHeap<Shorter> heap;
+};
+
+// 每個 priority 一個 FIFO 佇列 (RR within priority，priority 之間不搶佔)
+// 出現過的 priority 依大小對應到緊密的 level (PriorityLevels，數字越小越優先)，遇到新的 priority 時插入一個 level
+class PriorityRoundRobinQueue {
+public:
+    static constexpr bool preemptive = false;
+
+    explicit PriorityRoundRobinQueue(EventSimulator& sim)
+        : sim(sim), processes(sim.get_processes()), non_empty_levels(0) {}
+
+    void admit(int idx) {
+        in_queue.resize(sim.slot_count(), false);
+        enqueue(idx);
+    }
+    bool empty() const { return non_empty_levels.first_set() == -1; }
+    // 用 bitmap 直接找到最高優先級的非空佇列
+    int top() const { return level_queues[non_empty_levels.first_set()].front(); }
+    void pop() {
+        int level = non_empty_levels.first_set();
+        in_queue[level_queues[level].front()] = false;
+        level_queues[level].pop();
+        if (level_queues[level].empty()) {
+            non_empty_levels.clear(level);
+        }
+    }
+    void requeue_expired(int idx) { enqueue(idx); } // 放回其優先級佇列的尾部 (RR 行為)
+    void on_complete(int) {}
+    void block(int) {}
+    void wake(int idx) { enqueue(idx); }
+    int take() {
+        int idx = top();
+        pop();
+        return idx;
+    }
+
+    void save(SnapshotWriter& out) const { out.put(level_queues); }
+    void load(SnapshotReader& in) {
+        std::vector<std::queue<int>> saved;
+        in.get(saved);
+        in_queue.assign(sim.slot_count(), false);
+        for (auto& queue : saved) {
+            for (; !queue.empty(); queue.pop()) enqueue(queue.front());
+        }
+    }
+
+private:
+    void enqueue(int idx) {
+        if (in_queue[idx]) return;
+        bool inserted = false;
+        int level = levels.add(processes.priority[idx], inserted);
+        if (inserted) insert_level(level);
+        level_queues[level].push(idx);
+        non_empty_levels.set(level);
+        in_queue[idx] = true;
+    }
+
+    // 新的 priority 插在 level 的位置，之後的佇列往後移 (只有第一次遇到某個 priority 時發生)
+    void insert_level(int level) {
+        level_queues.insert(level_queues.begin() + level, std::queue<int>());
+        non_empty_levels = LevelBitmap(level_queues.size());
+        for (int l = 0; l < (int)level_queues.size(); l++) {
+            if (!level_queues[l].empty()) non_empty_levels.set(l);
+        }
+    }
+
+    EventSimulator& sim;
+    ProcessTable& processes;
+    PriorityLevels levels;
+    std::vector<std::queue<int>> level_queues;
+    LevelBitmap non_empty_levels; // 非空佇列的 bitmap
+    std::vector<bool> in_queue;   // O(1) 判斷行程是否已在佇列中
+};
+
+// multilevel feedback queue：新行程進入最高層，quantum 用完就降一層 (最低層放回同一層的尾部)
+// quantum 用完之前就去做 I/O 的行程 (interactive) 回來時留在原本的層級
+class FeedbackQueue {
+public:
+    static constexpr bool preemptive = false;
+
+    FeedbackQueue(EventSimulator& sim, int num_levels)
+        : sim(sim), level_queues(num_levels), non_empty_levels(num_levels), boost_count(0) {}
+
+    void admit(int idx) {
+        process_queue_level.resize(sim.slot_count(), -1);
+        blocked_boost_count.resize(sim.slot_count(), 0);
+        enqueue(idx, 0);
+    }
+    bool empty() const { return non_empty_levels.first_set() == -1; }
+    int top() const { return level_queues[non_empty_levels.first_set()].front(); }
+    void pop() {
+        int level = non_empty_levels.first_set();
+        level_queues[level].pop();
+        if (level_queues[level].empty()) {
+            non_empty_levels.clear(level);
+        }
+        TELEMETRY_LEVEL(sim, level, level_queues[level].size());
+    }
+    int level(int idx) const { return process_queue_level[idx]; } // 給 LevelQuantum 使用
+    void requeue_expired(int idx) {
+        enqueue(idx, std::min(process_queue_level[idx] + 1, (int)level_queues.size() - 1));
+    }
+    // priority boost 中斷執行中的行程：放回原本那一層的尾端，接著的 boost() 再移回最高層
+    void requeue_preempted(int idx) { enqueue(idx, process_queue_level[idx]); }
+    void on_complete(int idx) { process_queue_level[idx] = -1; }
+    void block(int idx) { blocked_boost_count[idx] = boost_count; }
+    // 做 I/O 的期間有 priority boost 時回到最高層
+    void wake(int idx) { enqueue(idx, blocked_boost_count[idx] == boost_count ? process_queue_level[idx] : 0); }
+    int take() {
+        int idx = top();
+        pop();
+        process_queue_level[idx] = -1;
+        return idx;
+    }
+
+    // 層數不同時 (resume 時改了 MLFQConfig)，超出的層併入最低層
+    void save(SnapshotWriter& out) const {
+        out.put(level_queues);
+        out.put(process_queue_level);
+        out.put(boost_count);
+        out.put(blocked_boost_count);
+    }
+    void load(SnapshotReader& in) {
+        std::vector<std::queue<int>> saved;
+        in.get(saved);
+        in.get(process_queue_level);
+        in.get(boost_count);
+        in.get(blocked_boost_count);
+        int lowest = (int)level_queues.size() - 1;
+        for (int& level : process_queue_level) {
+            level = std::min(level, lowest);
+        }
+        for (size_t level = 0; level < saved.size(); level++) {
+            for (; !saved[level].empty(); saved[level].pop()) {
+                enqueue(saved[level].front(), std::min((int)level, lowest));
+            }
+        }
+    }
+
+    // priority boost: 把所有等待中的行程移回最高層
+    // 依層級由高到低搬移，保持各層內部的 FIFO 順序
+    void boost() {
+        boost_count++;
+        for (int level = 1; level < (int)level_queues.size(); level++) {
+            if (!non_empty_levels.test(level)) continue;
+            while (!level_queues[level].empty()) {
+                enqueue(level_queues[level].front(), 0);
+                level_queues[level].pop();
+            }
+            non_empty_levels.clear(level);
+            TELEMETRY_LEVEL(sim, level, 0);
+        }
+    }
+
+private:
+    void enqueue(int idx, int level) {
+        level_queues[level].push(idx);
+        non_empty_levels.set(level);
+        process_queue_level[idx] = level;
+        TELEMETRY_LEVEL(sim, level, level_queues[level].size());
+    }
+
+    EventSimulator& sim;
+    std::vector<std::queue<int>> level_queues;
+    LevelBitmap non_empty_levels; // 非空佇列的 bitmap，O(1) 找到最高層
+    // 追蹤每個行程所在的佇列 (0 ~ num_levels-1, -1表示已完成或未到達)
+    std::vector<int> process_queue_level;
+    long long boost_count;
+    std::vector<long long> blocked_boost_count; // 開始做 I/O 時的 boost_count
+};
+
+// 最高 priority 優先，同一個 priority 中剩餘 burst time 最短的優先 (custom)
+// 更高 priority，或同 priority 但更短的行程會搶佔執行中的行程
+// 每個出現過的 priority 一個 bucket (PriorityLevels 依大小對應到緊密的索引)，bucket 內是 (remaining burst time, rank) 的 min-heap
+// 每次進入佇列都會拿到新的 rank：(priority, remaining burst time) 相同時最近被搶佔的行程優先，
+// 其次依 admit 的先後；被 remove() 或被選中的行程留在 heap 中的舊項目用 rank 判斷後直接丟掉
+class PriorityShortestQueue {
+public:
+    static constexpr bool preemptive = true;
+
+    explicit PriorityShortestQueue(EventSimulator& sim)
+        : sim(sim), processes(sim.get_processes()), next_admit_rank(0), next_preempt_rank(0),
+          non_empty_buckets(0) {}
+
+    void admit(int idx) {
+        tie_rank.resize(sim.slot_count(), 0);
+        waiting.resize(sim.slot_count(), false);
+        tie_rank[idx] = next_admit_rank++;
+        enqueue(idx);
+    }
+    bool empty() const { return non_empty_buckets.first_set() == -1; }
+    int top() {
+        auto& heap = bucket_heaps[non_empty_buckets.first_set()];
+        while (!is_live(heap.top())) {
+            heap.pop();
+        }
+        return heap.top().idx;
+    }
+    void pop() { // 呼叫前需先 top()
+        int bucket = non_empty_buckets.first_set();
+        int idx = bucket_heaps[bucket].top().idx;
+        bucket_heaps[bucket].pop();
+        waiting[idx] = false;
+        leave_bucket(bucket);
+    }
+    bool preempts(int candidate, int running) const {
+        return processes.priority[candidate] < processes.priority[running] ||
+               (processes.priority[candidate] == processes.priority[running] &&
+                processes.remaining_burst_time[candidate] < processes.remaining_burst_time[running]);
+    }
+    void requeue_preempted(int idx) {
+        tie_rank[idx] = --next_preempt_rank;
+        enqueue(idx);
+    }
+    void requeue_expired(int idx) {
+        tie_rank[idx] = next_admit_rank++;
+        enqueue(idx);
+    }
+    void on_complete(int) {}
+    void block(int) {}
+    void wake(int idx) { requeue_expired(idx); }
+    int take() {
+        int idx = top();
+        pop();
+        return idx;
+    }
+
+    // 給 aging policy 使用
+    long long rank(int idx) const { return tie_rank[idx]; }
+    bool is_waiting(int idx) const { return waiting[idx]; }
+    void remove(int idx) { // 從佇列中移除等待中的行程
+        waiting[idx] = false;
+        leave_bucket(buckets.find(processes.priority[idx]));
+    }
+
+    // 只保存還有效的項目 (每個等待中的行程一個，rank 都不同，所以取出的順序與保存前相同)
+    void save(SnapshotWriter& out) const {
+        out.put(tie_rank);
+        out.put(next_admit_rank);
+        out.put(next_preempt_rank);
+        out.put<std::uint64_t>(bucket_heaps.size());
+        for (auto heap : bucket_heaps) {
+            std::vector<HeapEntry> live;
+            for (; !heap.empty(); heap.pop()) {
+                if (is_live(heap.top())) live.push_back(heap.top());
+            }
+            out.put(live);
+        }
+    }
+    void load(SnapshotReader& in) {
+        std::uint64_t buckets = 0;
+        in.get(tie_rank);
+        in.get(next_admit_rank);
+        in.get(next_preempt_rank);
+        in.get(buckets);
+        tie_rank.resize(sim.slot_count(), 0);
+        waiting.assign(sim.slot_count(), false);
+        for (std::uint64_t bucket = 0; bucket < buckets && !in.failed(); bucket++) {
+            std::vector<HeapEntry> live;
+            in.get(live);
+            for (const HeapEntry& entry : live) enqueue(entry.idx);
+        }
+    }
+
+private:
+    struct HeapEntry {
+        SimTime remaining_burst_time;
+        long long rank;
+        int idx;
+    };
+    struct HeapEntryLater {
+        bool operator()(const HeapEntry& a, const HeapEntry& b) const {
+            if (a.remaining_burst_time != b.remaining_burst_time) {
+                return a.remaining_burst_time > b.remaining_burst_time;
+            }
+            return a.rank > b.rank;
+        }
+    };
+
+    bool is_live(const HeapEntry& entry) const {
+        return waiting[entry.idx] && tie_rank[entry.idx] == entry.rank;
+    }
+
+    // 行程開始在就緒佇列等待 (呼叫前需先設定 tie_rank)
+    void enqueue(int idx) {
+        bool inserted = false;
+        int bucket = buckets.add(processes.priority[idx], inserted);
+        if (inserted) insert_bucket(bucket);
+        waiting[idx] = true;
+        bucket_heaps[bucket].push(HeapEntry{processes.remaining_burst_time[idx], tie_rank[idx], idx});
+        bucket_size[bucket]++;
+        non_empty_buckets.set(bucket);
+    }
+
+    // 新的 priority 插在 bucket 的位置，之後的 bucket 往後移 (只有第一次遇到某個 priority 時發生)
+    void insert_bucket(int bucket) {
+        bucket_heaps.insert(bucket_heaps.begin() + bucket, BucketHeap());
+        bucket_size.insert(bucket_size.begin() + bucket, 0);
+        non_empty_buckets = LevelBitmap(bucket_heaps.size());
+        for (int b = 0; b < (int)bucket_heaps.size(); b++) {
+            if (bucket_size[b] > 0) non_empty_buckets.set(b);
+        }
+    }
+
+    void leave_bucket(int bucket) {
+        if (--bucket_size[bucket] == 0) {
+            non_empty_buckets.clear(bucket);
+        }
+    }
+
+    EventSimulator& sim;
+    ProcessTable& processes;
+    std::vector<long long> tie_rank;
+    long long next_admit_rank;
+    long long next_preempt_rank;
+    typedef std::priority_queue<HeapEntry, std::vector<HeapEntry>, HeapEntryLater> BucketHeap;
+
+    PriorityLevels buckets;
+    std::vector<BucketHeap> bucket_heaps;
+    std::vector<int> bucket_size;
+    LevelBitmap non_empty_buckets;
+    std::vector<bool> waiting;
+};
+
+// EDF：absolute deadline (arrival + deadline) 最早的優先，沒有 deadline 的行程排在所有有 deadline 的行程之後
+// deadline 相同 (或都沒有) 時 priority 高的優先，其次最近被搶佔的行程、admit 順序
+// deadline 更早的新行程會搶佔執行中的行程；等待中的行程 key 不會改變，所以每次決策都是 O(log n)
+// priority_fallback (hybrid) 時另外維護一個依 (priority, deadline) 排序的 heap：
+// EDF 最前面的行程已經不可能在 deadline 前完成 (現在 + 剩餘 burst time > deadline) 時視為 overload，
+// 改選 priority 最高的行程，避免 EDF 在 overload 時一路連鎖讓後面的行程都 miss (domino effect)
+class DeadlineQueue {
+public:
+    static constexpr bool preemptive = true;
+
+    DeadlineQueue(EventSimulator& sim, const EDFConfig& config)
+        : sim(sim), processes(sim.get_processes()), priority_fallback(config.priority_fallback),
+          next_admit_rank(0), next_preempt_rank(0),
+          by_deadline(0, EarlierDeadline{&processes, &due, &tie_rank}),
+          by_priority(0, HigherPriority{&processes, &due, &tie_rank}) {}
+
+    void admit(int idx) {
+        due.resize(sim.slot_count());
+        tie_rank.resize(sim.slot_count());
+        by_deadline.grow(sim.slot_count());
+        if (priority_fallback) by_priority.grow(sim.slot_count());
+        due[idx] = processes.deadline[idx] == -1 ? NO_DEADLINE : processes.arrival_time[idx] + processes.deadline[idx];
+        tie_rank[idx] = next_admit_rank++;
+        push(idx);
+    }
+    bool empty() const { return by_deadline.empty(); }
+    int top() const { return overloaded() ? by_priority.top() : by_deadline.top(); }
+    void pop() {
+        int idx = top();
+        by_deadline.erase(idx);
+        if (priority_fallback) by_priority.erase(idx);
+    }
+
+    bool preempts(int candidate, int running) const {
+        if (overloaded()) {
+            return processes.priority[candidate] < processes.priority[running] ||
+                   (processes.priority[candidate] == processes.priority[running] && due[candidate] < due[running]);
+        }
+        return due[candidate] < due[running] ||
+               (due[candidate] == due[running] && processes.priority[candidate] < processes.priority[running]);
+    }
+    void requeue_preempted(int idx) {
+        tie_rank[idx] = --next_preempt_rank;
+        push(idx);
+    }
+    void requeue_expired(int idx) {
+        tie_rank[idx] = next_admit_rank++;
+        push(idx);
+    }
+    void on_complete(int) {}
+    void block(int) {}
+    void wake(int idx) { requeue_expired(idx); } // deadline 是整個行程的，I/O 之後不變
+    int take() {
+        int idx = top();
+        pop();
+        return idx;
+    }
+
+    void save(SnapshotWriter& out) const {
+        out.put(due);
+        out.put(tie_rank);
+        out.put(next_admit_rank);
+        out.put(next_preempt_rank);
+        out.put(by_deadline.items());
+    }
+    void load(SnapshotReader& in) {
+        std::vector<int> items;
+        in.get(due);
+        in.get(tie_rank);
+        in.get(next_admit_rank);
+        in.get(next_preempt_rank);
+        in.get(items);
+        due.resize(sim.slot_count());
+        tie_rank.resize(sim.slot_count());
+        by_deadline.grow(sim.slot_count());
+        if (priority_fallback) by_priority.grow(sim.slot_count());
+        for (int idx : items) push(idx);
+    }
+
+    // EDF 最前面的行程已經趕不上 deadline (只有 hybrid 時會改用 priority)
+    bool overloaded() const {
+        if (!priority_fallback || by_deadline.empty()) return false;
+        int idx = by_deadline.top();
+        return due[idx] != NO_DEADLINE && sim.now() + processes.remaining_burst_time[idx] > due[idx];
+    }
+
+private:
+    static const SimTime NO_DEADLINE = LLONG_MAX;
+
+    struct EarlierDeadline {
+        const ProcessTable* processes;
+        const std::vector<SimTime>* due;
+        const std::vector<long long>* tie_rank;
+        bool operator()(int a_idx, int b_idx) const {
+            if ((*due)[a_idx] != (*due)[b_idx]) return (*due)[a_idx] < (*due)[b_idx];
+            if (processes->priority[a_idx] != processes->priority[b_idx]) {
+                return processes->priority[a_idx] < processes->priority[b_idx];
+            }
+            return (*tie_rank)[a_idx] < (*tie_rank)[b_idx];
+        }
+    };
+    struct HigherPriority {
+        const ProcessTable* processes;
+        const std::vector<SimTime>* due;
+        const std::vector<long long>* tie_rank;
+        bool operator()(int a_idx, int b_idx) const {
+            if (processes->priority[a_idx] != processes->priority[b_idx]) {
+                return processes->priority[a_idx] < processes->priority[b_idx];
+            }
+            if ((*due)[a_idx] != (*due)[b_idx]) return (*due)[a_idx] < (*due)[b_idx];
+            return (*tie_rank)[a_idx] < (*tie_rank)[b_idx];
+        }
+    };
+
+    void push(int idx) {
+        by_deadline.push(idx);
+        if (priority_fallback) by_priority.push(idx);
+    }
+
+    EventSimulator& sim;
+    ProcessTable& processes;
+    bool priority_fallback;
+    std::vector<SimTime> due; // absolute deadline，沒有 deadline 時為 NO_DEADLINE
+    std::vector<long long> tie_rank;
+    long long next_admit_rank;
+    long long next_preempt_rank;
+    IndexedMinHeap<EarlierDeadline> by_deadline;
+    IndexedMinHeap<HigherPriority> by_priority; // 只有 priority_fallback 時使用
+};
+
+// CFS：依 priority 換算的 weight (Linux 的 nice -> weight 表)
+inline long long cfs_weight(int priority, const CFSConfig& config) {
+    static const int NICE_TO_WEIGHT[40] = {
+        88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916, // nice -20 ~ -11
+        9548,  7620,  6100,  4904,  3906,  3121,  2501,  1991,  1586,  1277,  // nice -10 ~ -1
+        1024,  820,   655,   526,   423,   335,   272,   215,   172,   137,   // nice 0 ~ 9
+        110,   87,    70,    56,    45,    36,    29,    23,    18,    15     // nice 10 ~ 19
+    };
+    int nice = (priority - config.base_priority) * config.nice_per_priority;
+    return NICE_TO_WEIGHT[std::min(19, std::max(-20, nice)) + 20];
+}
+
+// CFS：可執行的行程依 weighted virtual runtime 排在紅黑樹 (std::set) 中，最左邊 (vruntime 最小) 的先執行
+// vruntime 的增加速度與 weight 成反比，所以長期下來每個行程分到的 CPU 時間與 weight 成正比
+// 新到達的行程從目前最小的 vruntime 開始，只有 vruntime 比執行中的行程少超過 wakeup_granularity 時才搶佔
+// 做完 I/O 回來的行程保留自己的 vruntime，但最多只落後 min_vruntime 半個 target_latency (sleeper credit)，
+// 所以 interactive 的行程醒來時可以優先執行，又不會因為睡很久而獨佔 CPU
+// 選擇、插入、移除都是 O(log n)，取最左邊的節點是 O(1)
+class FairQueue {
+public:
+    static constexpr bool preemptive = true;
+
+    FairQueue(EventSimulator& sim, const CFSConfig& config)
+        : sim(sim), processes(sim.get_processes()), config(config), current(-1), min_vruntime(0),
+          total_weight_sum(0), runnable(0), next_seq(0) {}
+
+    void admit(int idx) {
+        vruntime.resize(sim.slot_count(), 0);
+        weights.resize(sim.slot_count(), 0);
+        exec_start.resize(sim.slot_count(), 0);
+        weights[idx] = cfs_weight(processes.priority[idx], config);
+        update_min_vruntime();
+        vruntime[idx] = min_vruntime;
+        total_weight_sum += weights[idx];
+        runnable++;
+        insert(idx);
+    }
+    bool empty() const { return tree.empty(); }
+    int top() const { return tree.begin()->idx; }
+    void pop() {
+        int idx = tree.begin()->idx;
+        tree.erase(tree.begin());
+        current = idx;
+        exec_start[idx] = sim.now();
+    }
+
+    bool preempts(int candidate, int running) const {
+        return running_vruntime(running) - vruntime[candidate] > scaled(config.wakeup_granularity, weights[candidate]);
+    }
+    void requeue_preempted(int idx) {
+        account(idx);
+        insert(idx);
+    }
+    void requeue_expired(int idx) {
+        account(idx);
+        current = -1;
+        insert(idx);
+    }
+    void on_complete(int idx) {
+        account(idx);
+        current = -1;
+        total_weight_sum -= weights[idx];
+        runnable--;
+    }
+    void block(int idx) { on_complete(idx); } // 做 I/O 的期間不算可執行的行程
+    // 與 pop() 不同，不是換成執行中的行程 (current 不變)
+    int take() {
+        int idx = tree.begin()->idx;
+        tree.erase(tree.begin());
+        total_weight_sum -= weights[idx];
+        runnable--;
+        return idx;
+    }
+    void wake(int idx) {
+        update_min_vruntime();
+        vruntime[idx] = std::max(vruntime[idx], min_vruntime - scaled(config.target_latency / 2, NICE_0_WEIGHT));
+        total_weight_sum += weights[idx];
+        runnable++;
+        insert(idx);
+    }
+
+    // 給 FairSlice 使用 (可執行的行程含執行中的行程)
+    long long weight(int idx) const { return weights[idx]; }
+    long long total_weight() const { return total_weight_sum; }
+    long long runnable_count() const { return runnable; }
+
+    // weight 保留 admit 時換算的值
+    void save(SnapshotWriter& out) const {
+        out.put(std::vector<Node>(tree.begin(), tree.end()));
+        out.put(vruntime);
+        out.put(weights);
+        out.put(exec_start);
+        out.put(current);
+        out.put(min_vruntime);
+        out.put(total_weight_sum);
+        out.put(runnable);
+        out.put(next_seq);
+    }
+    void load(SnapshotReader& in) {
+        std::vector<Node> nodes;
+        in.get(nodes);
+        in.get(vruntime);
+        in.get(weights);
+        in.get(exec_start);
+        in.get(current);
+        in.get(min_vruntime);
+        in.get(total_weight_sum);
+        in.get(runnable);
+        in.get(next_seq);
+        tree.insert(nodes.begin(), nodes.end());
+    }
+
+private:
+    static const long long NICE_0_WEIGHT = 1024;
+    static const int VRUNTIME_SHIFT = 10; // vruntime 以 1/1024 ms 為單位，減少整數除法的誤差
+
+    struct Node {
+        long long vruntime;
+        long long seq; // vruntime 相同時先進先出
+        int idx;
+        bool operator<(const Node& other) const {
+            if (vruntime != other.vruntime) return vruntime < other.vruntime;
+            return seq < other.seq;
+        }
+    };
+
+    // 以 weight 執行 delta ms 對應的 vruntime
+    static long long scaled(SimTime delta, long long weight) {
+        return (delta * NICE_0_WEIGHT << VRUNTIME_SHIFT) / weight;
+    }
+    long long running_vruntime(int idx) const {
+        return vruntime[idx] + scaled(sim.now() - exec_start[idx], weights[idx]);
+    }
+    // 把從 exec_start 到現在的執行時間計入 vruntime
+    void account(int idx) {
+        vruntime[idx] = running_vruntime(idx);
+        exec_start[idx] = sim.now();
+    }
+    void insert(int idx) { tree.insert(Node{vruntime[idx], next_seq++, idx}); }
+    // min_vruntime 只會增加：新行程不會比已經在等待的行程更早執行太多
+    void update_min_vruntime() {
+        bool has_candidate = false;
+        long long candidate = 0;
+        if (current != -1) {
+            candidate = running_vruntime(current);
+            has_candidate = true;
+        }
+        if (!tree.empty() && (!has_candidate || tree.begin()->vruntime < candidate)) {
+            candidate = tree.begin()->vruntime;
+            has_candidate = true;
+        }
+        if (has_candidate) min_vruntime = std::max(min_vruntime, candidate);
+    }
+
+    EventSimulator& sim;
+    ProcessTable& processes;
+    CFSConfig config;
+    std::set<Node> tree;
+    std::vector<long long> vruntime;
+    std::vector<long long> weights;
+    std::vector<SimTime> exec_start; // 這次開始執行的時間
+    int current; // 執行中的行程，-1 表示CPU空閒
+    long long min_vruntime;
+    long long total_weight_sum;
+    long long runnable;
+    long long next_seq;
+};
+
+#endif // READY_QUEUES_H
@@ -0,0 +1,72 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "process.h"
+#include "scheduling.h"
+#include "event_sim.h"
+#include "workload.h"
+#include "latency_stats.h"
+#include "checkpoint.h"
+#include <vector>
+#include <string>
+#include <functional>
+
+typedef std::function<void(EventSimulator&)> SchedulerCore;
+
+// 對記憶體中的 workload 執行排程核心，收集每個行程的結果 (依 ID 排序) 與甘特圖
+// 每個行程完成時直接寫到結果表中預先算好的位置，不需要事後排序
+// arena 不為 nullptr 時重複使用其中的可變狀態
+// gantt_sink 不為 nullptr 時甘特圖邊模擬邊交給 sink，結果中的 gantt_timeline 是空的
+// record_gantt = false 時完全不記錄甘特圖 (sweep 等只需要統計的批次執行)，gantt_sink 不使用
+SchedulingResult simulate(const Workload& workload, const SchedulerCore& scheduler, SimulationArena* arena = nullptr,
+                          GanttSink* gantt_sink = nullptr, bool record_gantt = true);
+
+// simulate 並把甘特圖寫到 <gantt_prefix>_gantt_data.csv (模擬的同時由背景 thread 寫入)
+// 或 <gantt_prefix>_gantt_data.bin (binary 的標頭需要區間數量，模擬結束後才寫檔)
+SchedulingResult simulate_with_gantt_file(const Workload& workload, const SchedulerCore& scheduler,
+                                          const std::string& gantt_prefix, GanttFormat format);
+
+// 串流重播只保留彙總統計，不保留每個行程的結果，也不記錄甘特圖
+struct ReplaySummary {
+    long long completed_processes;
+    double avg_turnaround_time;
+    double avg_waiting_time;
+    long long context_switches;
+    SimTime makespan;
+    CpuUsage cpu_usage;
+    LatencyStats latency; // waiting / turnaround / response 的分布
+};
+
+ReplaySummary replay(ArrivalSource& source, const SchedulerCore& scheduler);
+
+// 重播時每隔 interval ms (模擬時間) 把目前的狀態 (模擬器、排程核心與到目前為止的統計) 寫成 checkpoint，
+// algorithm 是記錄在 checkpoint 中的名稱，resume 時用來找到對應的記錄
+ReplaySummary replay_with_checkpoints(ArrivalSource& source, const SchedulerCore& scheduler, const std::string& algorithm,
+                                      SimTime interval, CheckpointWriter& writer);
+
+// 從 checkpoint 繼續重播到結束 (source 必須是同一份 trace，從頭開始)，結果包含 checkpoint 之前的部分
+// scheduler 必須是同一個演算法，參數可以不同 (what-if)：新的參數從 checkpoint 的時間點開始套用
+// state 損毀或與排程核心不符時回傳 false
+bool resume_replay(ArrivalSource& source, const SchedulerCore& scheduler, const Checkpoint& checkpoint,
+                   ReplaySummary& summary);
+
+// 在 model 的 context switch 成本下執行排程核心 (model 不花時間時直接回傳 scheduler)
+SchedulerCore with_switch_cost(const SchedulerCore& scheduler, const SwitchCostModel& model);
+
+// scheduler_by_name 使用的參數 (只使用名稱對應的欄位)
+struct SchedulerParams {
+    RRPriorityConfig rr;
+    MLFQConfig mlfq;
+    AgingConfig aging;
+    CFSConfig cfs;
+};
+
+SchedulerParams default_scheduler_params();
+
+// 依名稱 (sjf / rr / mlfq / custom / cfs / edf / edf-hybrid) 取得排程核心，名稱不存在時回傳空的 function
+SchedulerCore scheduler_by_name(const std::string& name, const SchedulerParams& params);
+SchedulerCore scheduler_by_name(const std::string& name); // 使用預設參數
+
+void print_replay_summary(const ReplaySummary& summary, const std::string& algo_name);
+
+#endif // REPLAY_H
@@ -1,12 +1,120 @@
-#ifndef SCHEDULING_ALGORITHMS_H
-#define SCHEDULING_ALGORITHMS_H
-
-#include "process.h"
-#include <vector>
-
-void preemptive_sjf_scheduling(std::vector<Process> processes); // preemptive SJF
-void rr_priority_scheduling(std::vector<Process> processes);    // RR + priority
-void multilevel_feedback_queue_scheduling(std::vector<Process> processes); // MLFQ
-void custom_priority_sjf_aging_scheduling(std::vector<Process> processes); // customize
-
-#endif // SCHEDULING_ALGORITHMS_H
+#ifndef SCHEDULING_ALGORITHMS_H
+#define SCHEDULING_ALGORITHMS_H
+
+#include "process.h"
+#include "gantt.h"
+#include "telemetry.h"
+#include "event_sim.h"
+#include <vector>
+
+// MLFQ 每一層佇列的排程方式
+enum QueuePolicy {
+    POLICY_RR,   // Round-Robin，quantum 用完就降到下一層
+    POLICY_FCFS  // First-Come, First-Served，執行到完成
+};
+
+struct MLFQLevel {
+    QueuePolicy policy;
+    SimTime quantum; // (ms)，POLICY_FCFS 不使用
+};
+
+struct MLFQConfig {
+    std::vector<MLFQLevel> levels; // levels[0] 優先級最高
+    SimTime boost_interval;        // 每隔多少 ms 把所有行程移回 levels[0]，0 表示不 boost
+};
+
+// 預設設定：Q0 RR 5ms, Q1 RR 10ms, Q2 FCFS，不做 priority boost
+MLFQConfig default_mlfq_config();
+
+struct RRPriorityConfig {
+    SimTime quantum; // 同一個優先級內 RR 的 time quantum (ms)，須 > 0
+};
+
+// 預設設定：quantum 5ms
+RRPriorityConfig default_rr_priority_config();
+
+// custom (priority-based SJF with aging) 的 aging 參數
+struct AgingConfig {
+    SimTime threshold;  // 等待超過 threshold (ms) 觸發 aging，須 > 0
+    int priority_boost; // 每次 aging 的 priority 提升量 (數字越小 priority 越高，所以是減少)
+};
+
+// 預設設定：threshold 15ms，boost 1
+AgingConfig default_aging_config();
+
+// CFS (Completely Fair Scheduler) 的參數
+// 每個行程的 weight 依 priority 換算成 nice 值：nice = (priority - base_priority) x nice_per_priority，
+// 再查 Linux 的 nice -> weight 表 (nice 0 = 1024，每差 1 約差 1.25 倍)
+struct CFSConfig {
+    SimTime target_latency;     // 每個可執行的行程在這段時間內至少執行一次 (ms)，須 > 0
+    SimTime min_granularity;    // 每次至少執行多久 (ms)，須 > 0
+    SimTime wakeup_granularity; // 新到達的行程 vruntime 要比執行中的少超過這個值 (ms，以 nice 0 計) 才搶佔
+    int base_priority;          // 對應 nice 0 的 priority
+    int nice_per_priority;
+};
+
+// 預設設定：target latency 20ms，min granularity 2ms，wakeup granularity 1ms，priority 2 為 nice 0，每級 5 個 nice
+CFSConfig default_cfs_config();
+
+// EDF (Earliest Deadline First) 的參數
+// priority_fallback = true 時為 hybrid：EDF 最前面的行程已經趕不上 deadline (overload) 時改依 priority 選擇
+struct EDFConfig {
+    bool priority_fallback;
+};
+
+// 預設設定：純 EDF
+EDFConfig default_edf_config();
+
+class EventSimulator;
+class Workload;
+struct SimulationArena;
+
+// 排程核心：只透過 EventSimulator 取得到達的行程並回報完成，
+// 所以同一份程式可以接記憶體中的 vector，也可以接串流的 trace
+void schedule_preemptive_sjf(EventSimulator& sim);
+void schedule_rr_priority(EventSimulator& sim, const RRPriorityConfig& config);
+void schedule_multilevel_feedback_queue(EventSimulator& sim, const MLFQConfig& config);
+void schedule_custom_priority_sjf_aging(EventSimulator& sim, const AgingConfig& config);
+void schedule_cfs(EventSimulator& sim, const CFSConfig& config);
+void schedule_edf(EventSimulator& sim, const EDFConfig& config);
+
+// 一次排程的結果 (不做任何輸出，可以在多個 thread 中同時執行)
+struct SchedulingResult {
+    ProcessTable processes; // 依 ID 排序，含 completion_time
+    long long context_switches;
+    CpuUsage cpu_usage;
+    GanttTimeline gantt_timeline;
+    Telemetry telemetry; // 以 SCHED_TELEMETRY 編譯時才有資料
+};
+
+// workload 只讀不寫，可以同時給多個演算法 / thread 使用；arena 用來重複使用每次執行的可變狀態
+SchedulingResult run_preemptive_sjf(const Workload& workload, SimulationArena* arena = nullptr);
+SchedulingResult run_rr_priority(const Workload& workload,
+                                 const RRPriorityConfig& config = default_rr_priority_config(),
+                                 SimulationArena* arena = nullptr);
+SchedulingResult run_multilevel_feedback_queue(const Workload& workload,
+                                               const MLFQConfig& config = default_mlfq_config(),
+                                               SimulationArena* arena = nullptr);
+SchedulingResult run_custom_priority_sjf_aging(const Workload& workload,
+                                               const AgingConfig& config = default_aging_config(),
+                                               SimulationArena* arena = nullptr);
+SchedulingResult run_cfs(const Workload& workload, const CFSConfig& config = default_cfs_config(),
+                         SimulationArena* arena = nullptr);
+SchedulingResult run_edf(const Workload& workload, const EDFConfig& config = default_edf_config(),
+                         SimulationArena* arena = nullptr);
+
+// 執行排程並輸出甘特圖檔案 (<演算法>_gantt_data.csv 或 .bin) 與結果
+void preemptive_sjf_scheduling(const Workload& workload, GanttFormat gantt_format = GANTT_CSV); // preemptive SJF
+void rr_priority_scheduling(const Workload& workload,
+                            const RRPriorityConfig& config = default_rr_priority_config(),
+                            GanttFormat gantt_format = GANTT_CSV); // RR + priority
+void multilevel_feedback_queue_scheduling(const Workload& workload,
+                                          const MLFQConfig& config = default_mlfq_config(),
+                                          GanttFormat gantt_format = GANTT_CSV); // MLFQ
+void custom_priority_sjf_aging_scheduling(const Workload& workload,
+                                          const AgingConfig& config = default_aging_config(),
+                                          GanttFormat gantt_format = GANTT_CSV); // customize
+void cfs_scheduling(const Workload& workload, const CFSConfig& config = default_cfs_config(),
+                    GanttFormat gantt_format = GANTT_CSV); // CFS
+
+#endif // SCHEDULING_ALGORITHMS_H
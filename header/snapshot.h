@@ -0,0 +1,93 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "process.h"
+#include <vector>
+#include <deque>
+#include <queue>
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+// 排程狀態的 snapshot：模擬器、就緒佇列與 aging 的狀態依序寫成一段 byte 序列，之後可以從同一個時間點繼續模擬
+// 數值以原生的 byte order 與大小寫入 (與 binary trace 相同)，只保證在同一個平台與同一版程式讀回
+// 容器先寫元素數量 (uint64) 再寫每個元素
+
+class SnapshotWriter {
+public:
+    template <typename T> void put(const T& value) {
+        data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    template <typename T> void put(const std::vector<T>& values) { put_sequence(values); }
+    template <typename T> void put(const std::deque<T>& values) { put_sequence(values); }
+    template <typename T> void put(std::queue<T> values) { // 複製一份再依 FIFO 順序取出
+        put<std::uint64_t>(values.size());
+        while (!values.empty()) {
+            put(values.front());
+            values.pop();
+        }
+    }
+    void put(const ProcessTable& table);
+
+    const std::string& bytes() const { return data; }
+
+private:
+    template <typename Sequence> void put_sequence(const Sequence& values) {
+        put<std::uint64_t>(values.size());
+        for (const auto& value : values) {
+            put(static_cast<typename Sequence::value_type>(value));
+        }
+    }
+
+    std::string data;
+};
+
+// 讀到結尾之後或數量不合理時 failed()，之後讀到的值都是預設值
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const std::string& data) : data(data), offset(0), failed_read(false) {}
+
+    template <typename T> void get(T& value) {
+        if (failed_read || data.size() - offset < sizeof(T)) {
+            failed_read = true;
+            value = T();
+            return;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+    }
+    template <typename T> void get(std::vector<T>& values) { get_sequence(values); }
+    template <typename T> void get(std::deque<T>& values) { get_sequence(values); }
+    template <typename T> void get(std::queue<T>& values) {
+        std::deque<T> items;
+        get_sequence(items);
+        values = std::queue<T>(items);
+    }
+    void get(ProcessTable& table);
+
+    bool failed() const { return failed_read; }
+    bool at_end() const { return offset == data.size(); }
+    size_t position() const { return offset; } // 已讀取的 byte 數
+
+private:
+    template <typename Sequence> void get_sequence(Sequence& values) {
+        std::uint64_t count = 0;
+        get(count);
+        values.clear();
+        if (count > data.size() - offset) { // 每個元素至少 1 byte，避免損毀的數量配置大量記憶體
+            failed_read = true;
+            return;
+        }
+        for (std::uint64_t i = 0; i < count && !failed_read; i++) {
+            typename Sequence::value_type value;
+            get(value);
+            values.push_back(value);
+        }
+    }
+
+    const std::string& data;
+    size_t offset;
+    bool failed_read;
+};
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,55 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// bounded single-producer / single-consumer lock-free ring buffer
+// 只能有一個 thread 呼叫 try_push、一個 thread 呼叫 try_pop，兩邊都不需要 lock
+// head / tail 只會遞增，以 capacity (2 的次方) 取餘數得到位置
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t min_capacity) : head(0), tail(0) {
+        size_t capacity = 1;
+        while (capacity < min_capacity) capacity <<= 1;
+        items.resize(capacity);
+        mask = capacity - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // 佇列已滿時回傳 false，item 保持不變
+    bool try_push(T&& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == items.size()) return false;
+        items[t & mask] = std::move(item);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 佇列是空的時回傳 false
+    bool try_pop(T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        item = std::move(items[h & mask]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer 呼叫：是否沒有可以 pop 的 item
+    bool empty() const { return head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire); }
+    // producer 呼叫：是否沒有可以 push 的位置
+    bool full() const { return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire) == items.size(); }
+
+private:
+    std::vector<T> items;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head; // 只有 consumer 寫
+    alignas(64) std::atomic<size_t> tail; // 只有 producer 寫
+};
+
+#endif // SPSC_QUEUE_H
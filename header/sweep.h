@@ -0,0 +1,69 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "process.h"
+#include "scheduling.h"
+#include "workload.h"
+#include "replay.h"
+#include <vector>
+#include <string>
+#include <functional>
+
+// 參數掃描 (sweep)：對 seeds x process counts x algorithms 的每個組合執行一次排程，
+// 所有 (workload, algorithm) 工作在 work-stealing thread pool 上平行執行
+
+struct SweepAlgorithm {
+    std::string name;
+    // 同一個 workload 會同時給多個演算法使用；arena 是執行該工作的 thread 自己的
+    std::function<SchedulingResult(const Workload&, SimulationArena*)> run;
+};
+
+// 以 simulate 執行排程核心，套上 switch_cost 的 context switch 成本
+SweepAlgorithm sweep_algorithm(const std::string& name, const SchedulerCore& scheduler,
+                               const SwitchCostModel& switch_cost = default_switch_cost_model());
+
+// 預設的演算法 (SJF / RR / MLFQ / custom / CFS)，使用預設參數
+std::vector<SweepAlgorithm> default_sweep_algorithms(const SwitchCostModel& switch_cost = default_switch_cost_model());
+
+// 演算法參數的 grid (與 --tune 相同的選項)，空的 vector 表示只用預設值，名稱也不加上該參數
+struct SweepGrid {
+    std::vector<int> quantums;    // RR quantum，也是 MLFQ 的 Q0
+    std::vector<int> q1_quantums; // MLFQ 的 Q1
+    std::vector<int> thresholds;  // custom 的 aging threshold
+    std::vector<int> boosts;      // custom 的 aging priority boost
+    std::vector<int> mlfq_boosts; // 額外的 MLFQ 變體 (priority boost interval)，不取代預設的 MLFQ
+};
+
+// 每個參數組合一個演算法，名稱標示該組合，例如 "RR + Priority (q=10)"、"Custom (threshold=5 boost=2)"
+// grid 全部為空時與 default_sweep_algorithms 相同
+std::vector<SweepAlgorithm> grid_sweep_algorithms(const SweepGrid& grid,
+                                                  const SwitchCostModel& switch_cost = default_switch_cost_model());
+
+struct SweepConfig {
+    std::vector<unsigned int> seeds;
+    std::vector<int> process_counts;
+    std::vector<SweepAlgorithm> algorithms;
+    unsigned int num_threads; // 0 表示使用所有核心
+};
+
+struct SweepRow {
+    unsigned int seed;
+    int num_processes;
+    std::string algorithm;
+    double avg_turnaround_time;
+    double avg_waiting_time;
+    SimTime p99_waiting_time;
+    long long context_switches;
+    SimTime makespan; // 最後一個行程的完成時間
+};
+
+// 每個 (seed, num_processes) 的 workload 由 WorkloadGenerator (default_workload_spec) 以自己的 seed 產生，
+// 結果與 thread 數量及平台無關
+// 回傳順序固定為 seed -> process count -> algorithm
+std::vector<SweepRow> run_sweep(const SweepConfig& config);
+
+// 依 (process count, algorithm) 彙整所有 seed 的平均值
+void print_sweep_table(const std::vector<SweepRow>& rows);
+void save_sweep_results_to_csv(const std::vector<SweepRow>& rows, const std::string& filename);
+
+#endif // SWEEP_H
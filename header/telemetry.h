@@ -0,0 +1,94 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "process.h"
+#include <vector>
+#include <string>
+#include <chrono>
+
+// 排程器的 telemetry：ready queue 長度、MLFQ 各層佔用量 (時間序列)、搶佔次數、CPU 空閒比例，
+// 以及模擬器本身花在 selection 與 bookkeeping 的時間
+// 只有以 -DSCHED_TELEMETRY 編譯時才會記錄，否則下面的巨集全部展開為空，熱迴圈沒有任何額外成本
+
+enum TelemetryPhase {
+    TELEMETRY_NONE,        // 不計時
+    TELEMETRY_SELECTION,   // 從就緒佇列選出下一個行程
+    TELEMETRY_BOOKKEEPING  // 處理事件、admit、更新佇列與推進時間
+};
+
+// step function 的一個點：從 time 開始值為 value，直到下一個點
+struct TelemetrySample {
+    SimTime time;
+    long long value;
+};
+
+class Telemetry {
+public:
+    Telemetry()
+        : preemptions(0), busy_time(0), idle_time(0), selection_ns(0), bookkeeping_ns(0),
+          phase(TELEMETRY_NONE) {}
+
+    void record_ready_queue(SimTime time, long long length) { record_step(ready_queue, time, length); }
+    void record_level(SimTime time, int level, long long length) {
+        if (level >= (int)level_occupancy.size()) level_occupancy.resize(level + 1);
+        record_step(level_occupancy[level], time, length);
+    }
+    void count_preemption() { preemptions++; }
+    void add_busy(SimTime duration) { busy_time += duration; }
+    void add_idle(SimTime duration) { idle_time += duration; }
+
+    // 切換目前的計時階段，前一個階段經過的時間累加到對應的計數器
+    void enter_phase(TelemetryPhase next) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        long long elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - phase_start).count();
+        if (phase == TELEMETRY_SELECTION) selection_ns += elapsed;
+        if (phase == TELEMETRY_BOOKKEEPING) bookkeeping_ns += elapsed;
+        phase = next;
+        phase_start = now;
+    }
+
+    const std::vector<TelemetrySample>& get_ready_queue() const { return ready_queue; }
+    const std::vector<std::vector<TelemetrySample>>& get_level_occupancy() const { return level_occupancy; }
+    long long get_preemptions() const { return preemptions; }
+    SimTime get_busy_time() const { return busy_time; }
+    SimTime get_idle_time() const { return idle_time; }
+    double idle_fraction() const;
+    long long get_selection_ns() const { return selection_ns; }
+    long long get_bookkeeping_ns() const { return bookkeeping_ns; }
+
+private:
+    // 值沒變就不記錄，同一時間點的多次變化只保留最後一個值
+    static void record_step(std::vector<TelemetrySample>& series, SimTime time, long long value) {
+        if (!series.empty() && series.back().time == time) series.pop_back();
+        if (!series.empty() && series.back().value == value) return;
+        series.push_back(TelemetrySample{time, value});
+    }
+
+    std::vector<TelemetrySample> ready_queue;
+    std::vector<std::vector<TelemetrySample>> level_occupancy;
+    long long preemptions;
+    SimTime busy_time;
+    SimTime idle_time;
+    long long selection_ns;
+    long long bookkeeping_ns;
+    TelemetryPhase phase;
+    std::chrono::steady_clock::time_point phase_start;
+};
+
+#ifdef SCHED_TELEMETRY
+#define TELEMETRY_PHASE(sim, phase) (sim).get_telemetry().enter_phase(phase)
+#define TELEMETRY_LEVEL(sim, level, length) (sim).get_telemetry().record_level((sim).now(), (level), (length))
+#define TELEMETRY_PREEMPTION(sim) (sim).get_telemetry().count_preemption()
+#else
+#define TELEMETRY_PHASE(sim, phase) ((void)0)
+#define TELEMETRY_LEVEL(sim, level, length) ((void)0)
+#define TELEMETRY_PREEMPTION(sim) ((void)0)
+#endif
+
+void print_telemetry_summary(const Telemetry& telemetry);
+// 彙總數值與完整時間序列 ([time, value] 陣列)
+void save_telemetry_to_json(const Telemetry& telemetry, const std::string& algo_name, const std::string& filename);
+// 合併後的 step 時間序列：Time,ReadyQueue,Level0,Level1,...
+void save_telemetry_to_csv(const Telemetry& telemetry, const std::string& filename);
+
+#endif // TELEMETRY_H
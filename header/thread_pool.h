@@ -0,0 +1,49 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// work-stealing thread pool
+// 每個 worker 有自己的 deque：從自己的尾端取工作，自己沒有工作時從其他 worker 的前端偷
+class WorkStealingPool {
+public:
+    // num_threads = 0 時使用 hardware_concurrency()
+    explicit WorkStealingPool(unsigned int num_threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(std::function<void()> task);
+    void wait(); // 等到所有已送出的工作都完成
+
+    unsigned int size() const { return workers.size(); }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void worker_loop(unsigned int self);
+    bool try_pop(unsigned int self, std::function<void()>& task);
+
+    std::vector<std::thread> workers;
+    std::vector<WorkQueue> queues;
+    std::atomic<unsigned int> next_queue;
+
+    std::mutex state_mutex;
+    std::condition_variable work_available;
+    std::condition_variable all_done;
+    size_t queued_tasks;  // 還在 deque 中的工作數 (受 state_mutex 保護)
+    size_t pending_tasks; // 尚未完成的工作數 (受 state_mutex 保護)
+    bool stopping;
+};
+
+#endif // THREAD_POOL_H
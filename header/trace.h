@@ -0,0 +1,79 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "process.h"
+#include "event_sim.h"
+#include "output_pipeline.h"
+#include <vector>
+#include <string>
+#include <fstream>
+
+// workload trace 檔案格式 (兩種都必須依 arrival time 非遞減排序)：
+// - CSV: 標頭 "ProcessID,ArrivalTime,BurstTime,Priority[,Deadline[,Bursts]]"，之後每列一個行程
+// - binary: "TRCE" + uint32 version，之後每個行程為 int32 id, arrival, burst, priority
+//   (version 2 多一個 int32 deadline；version 3 再多一個 int32 n 與 n 個 int32 的 burst 序列)
+// Deadline 為相對於 arrival time 的 deadline (ms)，-1 或省略表示沒有 deadline
+// Bursts 為 CPU / I/O 交替的 burst 序列，CSV 中以 ';' 分隔 (例如 "4;10;3;20;5")，省略表示純 CPU 的行程
+// 有 Bursts 時 BurstTime 必須等於其中 CPU burst 的總和
+enum TraceFormat {
+    TRACE_CSV,
+    TRACE_BINARY
+};
+
+// 串流讀取 trace：每次只讀入 chunk_size 個行程，讀完再讀下一批，
+// 所以記憶體只跟 chunk 大小有關，跟 trace 的長度無關
+// 格式依檔頭自動判斷
+class TraceReader : public ArrivalSource {
+public:
+    explicit TraceReader(const std::string& filename, size_t chunk_size = 4096);
+
+    bool is_open() const { return opened; }
+    bool has_error() const { return error; } // 格式錯誤或 arrival time 沒有排序
+
+    bool has_next() override;
+    SimTime peek_arrival_time() override;
+    Process next() override;
+
+private:
+    void refill();
+    bool read_record(Process& p);
+    bool set_sequence(Process& p);
+    void fail(const std::string& message);
+
+    std::ifstream infile;
+    std::string filename;
+    TraceFormat format;
+    int binary_fields; // binary 每筆記錄固定的 int32 數量 (依 version)
+    bool binary_bursts; // version 3：固定欄位之後是 burst 序列
+    std::vector<SimTime> sequence;
+    size_t chunk_size;
+    std::vector<Process> chunk;
+    size_t chunk_pos;
+    bool opened;
+    bool eof;
+    bool error;
+    SimTime last_arrival_time;
+    long long record_number;
+};
+
+// 依 arrival time 順序逐筆寫入 trace，由背景 thread 寫檔 (AsyncFileWriter)
+// with_deadlines = false 時不寫 Deadline 欄位 (與舊版的檔案相同)，with_io = true 時另外寫 Bursts 欄位
+class TraceWriter {
+public:
+    TraceWriter(const std::string& filename, TraceFormat format, bool with_deadlines = false, bool with_io = false);
+
+    bool is_open() const { return output.is_open(); }
+    void write(const Process& p);
+    bool close() { return output.close(); } // 全部寫入成功時回傳 true
+
+private:
+    AsyncFileWriter output;
+    TraceFormat format;
+    bool with_deadlines;
+    bool with_io;
+};
+
+// 把記憶體中的行程依 arrival time (stable) 排序後寫成 trace，有任何行程有 deadline (I/O burst) 時才寫 Deadline (Bursts) 欄位
+bool save_processes_to_trace(const std::vector<Process>& processes, const std::string& filename, TraceFormat format);
+
+#endif // TRACE_H
@@ -0,0 +1,65 @@
+#ifndef TUNER_H
+#define TUNER_H
+
+#include "process.h"
+#include "scheduling.h"
+#include "workload.h"
+#include <vector>
+#include <string>
+
+// 排程參數自動調整：對一組 workload 評估參數 grid 中的每個候選，找出 objective 最小的參數
+// 候選在 work-stealing thread pool 上平行評估，每評估完一個 workload 就比較累計的 objective，
+// 已經比目前最佳值差的候選直接停止 (pruning)
+
+enum TunedAlgorithm {
+    TUNE_RR_PRIORITY, // RR quantum
+    TUNE_MLFQ,        // Q0 / Q1 quantum
+    TUNE_CUSTOM       // aging threshold / priority boost
+};
+
+// 一組候選參數 (只使用 algorithm 對應的欄位)
+struct TuningCandidate {
+    RRPriorityConfig rr;
+    MLFQConfig mlfq;
+    AgingConfig aging;
+};
+
+// objective = 所有 workload 的 (waiting time 百分位數 + penalty x 平均每個行程的 context switch 次數) 總和
+// 每一項都 >= 0，所以累計值只會變大，可以在評估到一半時 prune
+struct TuningObjective {
+    double waiting_percentile;     // 例如 99
+    double context_switch_penalty; // 一次 context switch 相當於多少 ms，須 >= 0
+};
+
+struct TunerConfig {
+    TunedAlgorithm algorithm;
+    std::vector<TuningCandidate> candidates;
+    TuningObjective objective;
+    SwitchCostModel switch_cost; // 模擬時 context switch 的成本 (與 objective 的 penalty 分開計算)
+    unsigned int num_threads;    // 0 表示使用所有核心
+};
+
+struct TuningResult {
+    double objective; // 被 prune 的候選為停止時的累計值
+    size_t workloads_evaluated;
+    bool pruned;
+};
+
+// 參數 grid
+std::vector<TuningCandidate> rr_priority_grid(const std::vector<int>& quantums);
+// Q0 x Q1 (只保留 q1 >= q0)，Q2 維持 FCFS
+std::vector<TuningCandidate> mlfq_grid(const std::vector<int>& q0_quantums, const std::vector<int>& q1_quantums);
+std::vector<TuningCandidate> aging_grid(const std::vector<int>& thresholds, const std::vector<int>& boosts);
+
+// 依 workloads 的順序評估，回傳與 candidates 同順序的結果
+// 最佳候選與 thread 數量無關 (objective 相同時取索引較小的)，但哪些候選被 prune 與執行順序有關
+std::vector<TuningResult> run_tuner(const TunerConfig& config, const std::vector<Workload>& workloads);
+size_t best_candidate(const std::vector<TuningResult>& results);
+
+std::string describe_candidate(TunedAlgorithm algorithm, const TuningCandidate& candidate);
+// 依 objective 列出前 top 個完整評估的候選
+void print_tuning_results(const TunerConfig& config, const std::vector<TuningResult>& results, size_t top);
+void save_tuning_results_to_csv(const TunerConfig& config, const std::vector<TuningResult>& results,
+                                const std::string& filename);
+
+#endif // TUNER_H
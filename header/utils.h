@@ -1,13 +1,20 @@
-#ifndef UTILS_H
-#define UTILS_H
-
-#include "Process.h"
-#include <vector>
-#include <string>
-#include <map>
-
-void print_results(const std::vector<Process>& processes, int context_switches, const std::string& algo_name);
-void print_gantt_chart(const std::map<int, int>& gantt_chart_data);
-void save_gantt_chart_data_to_csv(const std::map<int, int>& gantt_chart_data, const std::string& filename);
-
-#endif // UTILS_H
+#ifndef UTILS_H
+#define UTILS_H
+
+#include "process.h"
+#include "gantt.h"
+#include "event_sim.h"
+#include <vector>
+#include <string>
+
+void print_results(const ProcessTable& processes, long long context_switches, const CpuUsage& usage,
+                   const std::string& algo_name);
+// CPU utilization、throughput (jobs/sec)，有 I/O 時另外輸出 I/O overlap
+void print_cpu_usage(const CpuUsage& usage, long long completed_processes, SimTime makespan);
+void print_gantt_chart(const GanttTimeline& gantt_timeline);
+// 每個區間一列：Start,End,ProcessID
+void save_gantt_chart_data_to_csv(const GanttTimeline& gantt_timeline, const std::string& filename);
+// binary 格式："GNTT" + uint32 version (2) + uint64 區間數，之後每個區間為 int64 start, end + int32 pid
+void save_gantt_chart_data_to_binary(const GanttTimeline& gantt_timeline, const std::string& filename);
+
+#endif // UTILS_H
@@ -0,0 +1,65 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "process.h"
+#include "event_sim.h"
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+// 不可變的 workload：依 arrival time (stable) 排序後以 struct-of-arrays 存放
+// 只建立一次，所有演算法 (以及多個 thread) 共用同一份，不再各自複製與排序
+// 每一列也預先算好結果表中的位置 (依 ID 排序)，排程結果可以直接寫到該位置
+class Workload {
+public:
+    Workload() {}
+    explicit Workload(const std::vector<Process>& processes);
+
+    size_t size() const { return ids.size(); }
+    bool empty() const { return ids.empty(); }
+
+    // row 為依 arrival 順序的索引
+    int id(size_t row) const { return ids[row]; }
+    SimTime arrival_time(size_t row) const { return arrival_times[row]; }
+    SimTime burst_time(size_t row) const { return burst_times[row]; }
+    int priority(size_t row) const { return priorities[row]; }
+    SimTime deadline(size_t row) const { return deadlines[row]; } // 相對 deadline，-1 表示沒有
+    bool has_io() const { return !sequence_offsets.empty(); }     // 是否有行程含 I/O burst
+    size_t result_position(size_t row) const { return result_positions[row]; }
+    Process process(size_t row) const;
+    // 把第 row 列寫到 table 的第 slot 列 (與 table.assign(slot, process(row)) 相同)，
+    // 不建立 Process；burst 序列直接從 sequence_pool 複製到 slot 原本的 vector，容量夠時不需要配置
+    void write_row(size_t row, ProcessTable& table, size_t slot) const;
+
+private:
+    SimTime io_time(size_t row) const; // 含 I/O 的列才可以呼叫
+
+    std::vector<std::int32_t> ids;
+    std::vector<SimTime> arrival_times;
+    std::vector<SimTime> burst_times;
+    std::vector<std::int16_t> priorities;
+    std::vector<SimTime> deadlines;
+    // 含 I/O 的行程的 burst 序列集中存放：第 row 列為 sequence_pool[sequence_offsets[row], sequence_offsets[row + 1])
+    // 所有行程都是純 CPU 時兩個都是空的
+    std::vector<std::int64_t> sequence_offsets;
+    std::vector<SimTime> sequence_pool;
+    std::vector<std::int32_t> result_positions; // 依 ID (stable) 排序後的位置
+};
+
+// 依 arrival 順序逐列提供 workload 中的行程，不會修改 workload
+class WorkloadSource : public ArrivalSource {
+public:
+    explicit WorkloadSource(const Workload& workload) : workload(workload), cursor(0) {}
+
+    bool has_next() override { return cursor < workload.size(); }
+    SimTime peek_arrival_time() override { return workload.arrival_time(cursor); }
+    Process next() override { return workload.process(cursor++); }
+    void next_into(ProcessTable& table, size_t slot) override { workload.write_row(cursor++, table, slot); }
+    void skip(long long count) override { cursor = std::min<size_t>(cursor + count, workload.size()); }
+
+private:
+    const Workload& workload;
+    size_t cursor;
+};
+
+#endif // WORKLOAD_H
@@ -0,0 +1,39 @@
+#include "scheduling.h"
+#include "utils.h"
+#include "event_sim.h"
+#include "policy_engine.h"
+#include "ready_queues.h"
+#include "replay.h"
+#include <iostream>
+
+using namespace std;
+
+CFSConfig default_cfs_config() {
+    return CFSConfig{20, 2, 1, 2, 5};
+}
+
+// CFS (Completely Fair Scheduler)：依 priority 換算的 weight 按比例分配 CPU 時間
+void schedule_cfs(EventSimulator& sim, const CFSConfig& config) {
+    FairQueue ready_queue(sim, config);
+    NoAging aging; // vruntime 本身就不會讓行程 starvation
+    run_policy_engine(sim, ready_queue, FairSlice{config}, aging);
+}
+
+SchedulingResult run_cfs(const Workload& workload, const CFSConfig& config, SimulationArena* arena) {
+    return simulate(workload, [&config](EventSimulator& sim) {
+        schedule_cfs(sim, config);
+    }, arena);
+}
+
+void cfs_scheduling(const Workload& workload, const CFSConfig& config, GanttFormat gantt_format) {
+    cout << "\n--- Starting CFS (Completely Fair Scheduler) Scheduling ---\n";
+    SchedulingResult result = simulate_with_gantt_file(workload, [&config](EventSimulator& sim) {
+        schedule_cfs(sim, config);
+    }, "CFS", gantt_format);
+    print_results(result.processes, result.context_switches, result.cpu_usage, "CFS (Completely Fair Scheduler)");
+#ifdef SCHED_TELEMETRY
+    print_telemetry_summary(result.telemetry);
+    save_telemetry_to_json(result.telemetry, "CFS (Completely Fair Scheduler)", "CFS_telemetry.json");
+    save_telemetry_to_csv(result.telemetry, "CFS_telemetry.csv");
+#endif
+}
@@ -0,0 +1,25 @@
+#include "scheduling.h"
+#include "event_sim.h"
+#include "policy_engine.h"
+#include "ready_queues.h"
+#include "replay.h"
+
+using namespace std;
+
+EDFConfig default_edf_config() {
+    return EDFConfig{false};
+}
+
+// EDF (Earliest Deadline First)：absolute deadline 最早的行程優先，可以搶佔
+// priority_fallback 時 overload 改依 priority 選擇 (hybrid)
+void schedule_edf(EventSimulator& sim, const EDFConfig& config) {
+    DeadlineQueue ready_queue(sim, config);
+    NoAging aging; // 沒有 deadline 的行程依 priority 排在最後，不做 aging
+    run_policy_engine(sim, ready_queue, RunToCompletion(), aging);
+}
+
+SchedulingResult run_edf(const Workload& workload, const EDFConfig& config, SimulationArena* arena) {
+    return simulate(workload, [&config](EventSimulator& sim) {
+        schedule_edf(sim, config);
+    }, arena);
+}
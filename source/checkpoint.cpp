@@ -0,0 +1,102 @@
+#include "checkpoint.h"
+#include <iostream>
+
+using namespace std;
+
+static const uint32_t CHECKPOINT_VERSION = 1;
+static const uint32_t MAX_ALGORITHM_NAME = 256; // 檢查檔案損毀
+
+static uint64_t fnv1a(const string& data) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+template <typename T> static void write_value(ofstream& output, const T& value) {
+    output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T> static bool read_value(ifstream& input, T& value) {
+    return static_cast<bool>(input.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+CheckpointWriter::CheckpointWriter(const string& filename) : output(filename, ios::binary), count(0) {
+    if (!output.is_open()) {
+        cerr << "Error: Could not open file " << filename << " for writing checkpoints." << endl;
+        return;
+    }
+    output.write("CKPT", 4);
+    write_value(output, CHECKPOINT_VERSION);
+}
+
+void CheckpointWriter::write(SimTime time, const string& algorithm, const string& state) {
+    write_value<int64_t>(output, time);
+    write_value<uint32_t>(output, algorithm.size());
+    output.write(algorithm.data(), algorithm.size());
+    write_value<uint64_t>(output, state.size());
+    write_value(output, fnv1a(state));
+    output.write(state.data(), state.size());
+    output.flush(); // 模擬中途中斷時已寫入的 checkpoint 仍然可以使用
+    count++;
+}
+
+bool CheckpointWriter::close() {
+    output.close();
+    return !output.fail();
+}
+
+bool find_checkpoint(const string& filename, const string& algorithm, SimTime at, Checkpoint& checkpoint) {
+    ifstream input(filename, ios::binary);
+    if (!input.is_open()) {
+        cerr << "Error: Could not open checkpoint file " << filename << endl;
+        return false;
+    }
+    input.seekg(0, ios::end);
+    uint64_t file_size = input.tellg();
+    input.seekg(0);
+    char magic[4];
+    uint32_t version = 0;
+    if (!input.read(magic, 4) || string(magic, 4) != "CKPT" || !read_value(input, version) ||
+        version != CHECKPOINT_VERSION) {
+        cerr << "Error: " << filename << " is not a checkpoint file (version " << CHECKPOINT_VERSION << ")" << endl;
+        return false;
+    }
+
+    // 依序掃過所有記錄，只有符合的記錄才讀入 state
+    bool found = false;
+    int64_t time = 0;
+    while (read_value(input, time)) {
+        uint32_t name_length = 0;
+        uint64_t state_length = 0;
+        uint64_t checksum = 0;
+        if (!read_value(input, name_length) || name_length > MAX_ALGORITHM_NAME) break;
+        string name(name_length, '\0');
+        if (!input.read(&name[0], name_length) || !read_value(input, state_length) || !read_value(input, checksum)) {
+            break;
+        }
+        if (state_length > file_size - (uint64_t)input.tellg()) break; // 最後一筆沒寫完 (模擬中途中斷)
+        if (name != algorithm || (at != -1 && time > at)) {
+            if (!input.seekg(state_length, ios::cur)) break;
+            continue;
+        }
+        string state;
+        state.resize(state_length);
+        if (state_length > 0 && !input.read(&state[0], state_length)) break;
+        if (fnv1a(state) != checksum) {
+            cerr << "Error: checkpoint at time " << time << " in " << filename << " is corrupted" << endl;
+            return false;
+        }
+        checkpoint.time = time;
+        checkpoint.algorithm = name;
+        checkpoint.state.swap(state);
+        found = true;
+    }
+    if (!found) {
+        cerr << "Error: no checkpoint for " << algorithm << (at != -1 ? " at or before time " + to_string(at) : "")
+             << " in " << filename << endl;
+    }
+    return found;
+}
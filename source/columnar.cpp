@@ -0,0 +1,239 @@
+#include "columnar.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static const uint32_t COLUMNAR_VERSION = 1;
+static const uint32_t COLUMNAR_VERSION_DEADLINES = 2; // 多一個 deadline 欄位
+static const int COLUMNAR_NUM_COLUMNS = 4;
+
+MappedWorkload::MappedWorkload()
+    : mapped(nullptr), mapped_size(0), count(0), num_columns(COLUMNAR_NUM_COLUMNS)
+#ifdef _WIN32
+      , file_handle(nullptr), mapping_handle(nullptr)
+#else
+      , fd(-1)
+#endif
+{}
+
+MappedWorkload::~MappedWorkload() {
+    close();
+}
+
+bool MappedWorkload::open(const string& filename) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        cerr << "Error: Could not open workload file " << filename << endl;
+        return false;
+    }
+    file_handle = file;
+    LARGE_INTEGER file_size;
+    GetFileSizeEx(file, &file_size);
+    mapped_size = static_cast<size_t>(file_size.QuadPart);
+    if (mapped_size > 0) {
+        mapping_handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_handle != nullptr) {
+            mapped = static_cast<const unsigned char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+        }
+    }
+#else
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cerr << "Error: Could not open workload file " << filename << endl;
+        return false;
+    }
+    struct stat st;
+    fstat(fd, &st);
+    mapped_size = st.st_size;
+    if (mapped_size > 0) {
+        void* addr = mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            mapped = static_cast<const unsigned char*>(addr);
+            madvise(addr, mapped_size, MADV_SEQUENTIAL); // 依列的順序讀取
+        }
+    }
+#endif
+
+    if (mapped == nullptr || mapped_size < sizeof(ColumnarHeader)) {
+        cerr << "Error: " << filename << " is not a columnar workload file" << endl;
+        close();
+        return false;
+    }
+
+    ColumnarHeader header;
+    memcpy(&header, mapped, sizeof(header));
+    if (memcmp(header.magic, "WKLD", 4) != 0 ||
+        (header.version != COLUMNAR_VERSION && header.version != COLUMNAR_VERSION_DEADLINES)) {
+        cerr << "Error: " << filename << " has an unsupported columnar header" << endl;
+        close();
+        return false;
+    }
+    num_columns = header.version == COLUMNAR_VERSION_DEADLINES ? COLUMNAR_NUM_COLUMNS + 1 : COLUMNAR_NUM_COLUMNS;
+    if ((mapped_size - sizeof(ColumnarHeader)) / (num_columns * sizeof(int32_t)) < header.count) {
+        cerr << "Error: " << filename << " is truncated" << endl;
+        close();
+        return false;
+    }
+    count = header.count;
+    if (!validate_rows(filename)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+// 與 TraceReader 相同的檢查 (O(n)，只掃過一次 mmap 的欄位)
+bool MappedWorkload::validate_rows(const string& filename) const {
+    ColumnView arrival_column = arrival_times();
+    ColumnView burst_column = burst_times();
+    ColumnView priority_column = priorities();
+    ColumnView deadline_column = deadlines();
+    SimTime last_arrival_time = 0;
+    for (size_t i = 0; i < count; i++) {
+        const char* message = nullptr;
+        if (arrival_column[i] < last_arrival_time) {
+            message = "arrival times are not sorted";
+        } else if (burst_column[i] <= 0) {
+            message = "burst time must be positive";
+        } else if (priority_column[i] < 0 || priority_column[i] > INT16_MAX) {
+            message = "priority must be in [0, 32767]";
+        } else if (deadline_column.size() > 0 && deadline_column[i] <= 0 && deadline_column[i] != -1) {
+            message = "deadline must be positive (or -1 for none)";
+        }
+        if (message != nullptr) {
+            cerr << "Error: " << filename << " (row " << i + 1 << "): " << message << endl;
+            return false;
+        }
+        last_arrival_time = arrival_column[i];
+    }
+    return true;
+}
+
+void MappedWorkload::close() {
+#ifdef _WIN32
+    if (mapped != nullptr) UnmapViewOfFile(mapped);
+    if (mapping_handle != nullptr) CloseHandle(mapping_handle);
+    if (file_handle != nullptr) CloseHandle(file_handle);
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+#else
+    if (mapped != nullptr) munmap(const_cast<unsigned char*>(mapped), mapped_size);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    mapped = nullptr;
+    mapped_size = 0;
+    count = 0;
+    num_columns = COLUMNAR_NUM_COLUMNS;
+}
+
+ColumnView MappedWorkload::column(int index) const {
+    if (mapped == nullptr) return ColumnView();
+    const unsigned char* start = mapped + sizeof(ColumnarHeader) + index * count * sizeof(int32_t);
+    return ColumnView(reinterpret_cast<const int32_t*>(start), count);
+}
+
+MappedWorkloadSource::MappedWorkloadSource(const MappedWorkload& workload)
+    : ids(workload.ids()), arrival_times(workload.arrival_times()),
+      burst_times(workload.burst_times()), priorities(workload.priorities()),
+      deadlines(workload.deadlines()), cursor(0) {}
+
+Process MappedWorkloadSource::next() {
+    size_t i = cursor++;
+    return Process(ids[i], arrival_times[i], burst_times[i], priorities[i], deadlines.size() > 0 ? deadlines[i] : -1);
+}
+
+bool is_columnar_workload(const string& filename) {
+    ifstream infile(filename, ios::binary);
+    char magic[4] = {0, 0, 0, 0};
+    infile.read(magic, 4);
+    return infile.gcount() == 4 && memcmp(magic, "WKLD", 4) == 0;
+}
+
+ColumnarWriter::ColumnarWriter(const string& filename, size_t count, bool with_deadlines)
+    : outfile(filename, ios::binary), count(count), written(0),
+      num_columns(with_deadlines ? COLUMNAR_NUM_COLUMNS + 1 : COLUMNAR_NUM_COLUMNS) {
+    if (!outfile.is_open()) {
+        cerr << "Error: Could not open file " << filename << " for writing workload." << endl;
+        return;
+    }
+    ColumnarHeader header;
+    memcpy(header.magic, "WKLD", 4);
+    header.version = with_deadlines ? COLUMNAR_VERSION_DEADLINES : COLUMNAR_VERSION;
+    header.count = count;
+    header.reserved = 0;
+    outfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (int c = 0; c < num_columns; c++) {
+        columns[c].reserve(BUFFERED_ROWS);
+    }
+}
+
+void ColumnarWriter::write(const Process& p) {
+    columns[0].push_back(static_cast<int32_t>(p.id));
+    columns[1].push_back(static_cast<int32_t>(p.arrival_time));
+    columns[2].push_back(static_cast<int32_t>(p.burst_time));
+    columns[3].push_back(static_cast<int32_t>(p.priority));
+    if (num_columns > COLUMNAR_NUM_COLUMNS) columns[4].push_back(static_cast<int32_t>(p.deadline));
+    if (columns[0].size() == BUFFERED_ROWS) flush_columns();
+}
+
+void ColumnarWriter::flush_columns() {
+    size_t rows = min(columns[0].size(), count - min(written, count)); // 超過 count 的部分不寫
+    for (int c = 0; c < num_columns; c++) {
+        if (rows > 0) {
+            outfile.seekp(sizeof(ColumnarHeader) + (c * count + written) * sizeof(int32_t));
+            outfile.write(reinterpret_cast<const char*>(columns[c].data()), rows * sizeof(int32_t));
+        }
+    }
+    written += columns[0].size();
+    for (auto& column : columns) {
+        column.clear();
+    }
+}
+
+bool ColumnarWriter::close() {
+    if (!is_open()) return false;
+    flush_columns();
+    bool ok = outfile.good() && written == count;
+    outfile.close();
+    return ok && !outfile.fail();
+}
+
+bool save_processes_to_columnar(const vector<Process>& processes, const string& filename) {
+    bool with_deadlines = any_of(processes.begin(), processes.end(), [](const Process& p) {
+        return p.deadline != -1;
+    });
+    if (any_of(processes.begin(), processes.end(), [](const Process& p) { return !p.bursts.empty(); })) {
+        cerr << "Error: columnar workloads cannot hold I/O bursts, use a csv or binary trace" << endl;
+        return false;
+    }
+    ColumnarWriter writer(filename, processes.size(), with_deadlines);
+    if (!writer.is_open()) return false;
+
+    VectorArrivalSource source(processes); // 依 arrival time (stable) 排序
+    while (source.has_next()) {
+        writer.write(source.next());
+    }
+    if (!writer.close()) {
+        cerr << "Error: Failed to write workload to " << filename << endl;
+        return false;
+    }
+    cout << "Workload saved to " << filename << endl;
+    return true;
+}
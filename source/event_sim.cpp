@@ -0,0 +1,303 @@
+#include "event_sim.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+VectorArrivalSource::VectorArrivalSource(const vector<Process>& processes)
+    : processes(processes), cursor(0) {
+    for (size_t i = 0; i < processes.size(); i++) {
+        order.push_back(i);
+    }
+    // stable sort: 同時到達的行程維持原本的索引順序
+    stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return processes[a].arrival_time < processes[b].arrival_time;
+    });
+}
+
+SwitchCostModel default_switch_cost_model() {
+    return SwitchCostModel{0, 0, 0};
+}
+
+bool validate_switch_cost_model(const SwitchCostModel& model) {
+    if (model.dispatch < 0 || model.cache_warmup < 0 || model.cache_decay < 0) {
+        cerr << "Error: switch cost, cache penalty and cache decay must not be negative" << endl;
+        return false;
+    }
+    return true;
+}
+
+void SimulationArena::clear() {
+    slots.clear();
+    free_slots.clear();
+    tokens.clear();
+    admission_index.clear();
+    events.clear();
+}
+
+EventSimulator::EventSimulator(ArrivalSource& source, CompletionCallback on_complete, bool record_gantt,
+                               SimulationArena* shared_arena)
+    : source(source), on_complete(on_complete), arena(shared_arena != nullptr ? *shared_arena : own_arena),
+      live_processes(0), blocked_processes(0), ready_work_total(0), admitted(0), record_gantt(record_gantt),
+      current_time(0), context_switches(0), dispatches(0), usage(CpuUsage{0, 0, 0, 0}), prev_proc_id(-1),
+      switch_cost(default_switch_cost_model()), pending_switch(0), cache_owner_id(-1), checkpoint_sink(nullptr),
+      checkpoint_interval(0), next_checkpoint_time(0), resuming(false), resume_error(false) {
+    arena.clear();
+}
+
+bool EventSimulator::done() {
+    return live_processes == 0 && !source.has_next();
+}
+
+bool EventSimulator::has_arrival_due() {
+    return source.has_next() && source.peek_arrival_time() <= current_time;
+}
+
+int EventSimulator::pop_arrival() {
+    int idx;
+    if (!arena.free_slots.empty()) {
+        idx = arena.free_slots.back();
+        arena.free_slots.pop_back();
+        arena.admission_index[idx] = admitted++;
+    } else {
+        idx = arena.slots.size();
+        arena.slots.resize(idx + 1);
+        arena.tokens.push_back(0);
+        arena.admission_index.push_back(admitted++);
+    }
+    source.next_into(arena.slots, idx); // 重複使用的 slot 保留 burst 序列的容量
+    live_processes++;
+    ready_work_total += arena.slots.remaining_burst_time[idx];
+    return idx;
+}
+
+void EventSimulator::complete(int proc_idx) {
+    arena.slots.completion_time[proc_idx] = current_time;
+    on_complete(arena.slots, proc_idx);
+    cancel_events(proc_idx); // slot 之後會給別的行程使用
+    arena.free_slots.push_back(proc_idx);
+    live_processes--;
+}
+
+void EventSimulator::release(int proc_idx) {
+    ready_work_total -= arena.slots.remaining_burst_time[proc_idx];
+    cancel_events(proc_idx);
+    arena.free_slots.push_back(proc_idx);
+    live_processes--;
+}
+
+bool EventSimulator::last_burst(int proc_idx) const {
+    return arena.slots.burst_index[proc_idx] + 1 >= (int)arena.slots.bursts[proc_idx].size();
+}
+
+void EventSimulator::start_io(int proc_idx) {
+    int index = ++arena.slots.burst_index[proc_idx];
+    blocked_processes++;
+    schedule(current_time + arena.slots.bursts[proc_idx][index], EVENT_IO_COMPLETION, proc_idx);
+}
+
+void EventSimulator::finish_io(int proc_idx) {
+    int index = ++arena.slots.burst_index[proc_idx];
+    arena.slots.remaining_burst_time[proc_idx] = arena.slots.bursts[proc_idx][index];
+    ready_work_total += arena.slots.remaining_burst_time[proc_idx];
+    blocked_processes--;
+}
+
+void EventSimulator::schedule(SimTime time, EventType type, int proc_idx) {
+    arena.events.push_back(Event{time, type, proc_idx, arena.tokens[proc_idx]});
+    push_heap(arena.events.begin(), arena.events.end(), EventLater());
+}
+
+void EventSimulator::cancel_events(int proc_idx) {
+    arena.tokens[proc_idx]++; // lazy cancellation: 舊 token 的事件在 pop 時丟掉
+}
+
+void EventSimulator::drop_cancelled() {
+    vector<Event>& events = arena.events;
+    while (!events.empty() && events.front().token != arena.tokens[events.front().proc_idx]) {
+        pop_heap(events.begin(), events.end(), EventLater());
+        events.pop_back();
+    }
+}
+
+bool EventSimulator::has_event_due() {
+    drop_cancelled();
+    return !arena.events.empty() && arena.events.front().time <= current_time;
+}
+
+Event EventSimulator::pop_event() {
+    drop_cancelled();
+    Event e = arena.events.front();
+    pop_heap(arena.events.begin(), arena.events.end(), EventLater());
+    arena.events.pop_back();
+    return e;
+}
+
+SimTime EventSimulator::peek_event_time() {
+    drop_cancelled();
+    return arena.events.empty() ? -1 : arena.events.front().time;
+}
+
+SimTime EventSimulator::next_event_time() {
+    drop_cancelled();
+    SimTime next_time = -1;
+    if (source.has_next()) {
+        next_time = source.peek_arrival_time();
+    }
+    if (!arena.events.empty() && (next_time == -1 || arena.events.front().time < next_time)) {
+        next_time = arena.events.front().time;
+    }
+    return next_time;
+}
+
+SimTime EventSimulator::warmup_penalty(int proc_idx) const {
+    if (switch_cost.cache_warmup == 0 || arena.slots.id[proc_idx] == cache_owner_id) return 0;
+    SimTime off_cpu_time = arena.slots.off_cpu_time[proc_idx];
+    if (off_cpu_time == -1 || switch_cost.cache_decay == 0) return switch_cost.cache_warmup; // cache 是冷的
+    double warmth = exp(-(double)(current_time - off_cpu_time) / switch_cost.cache_decay);
+    return llround(switch_cost.cache_warmup * (1 - warmth));
+}
+
+SimTime EventSimulator::dispatch(int proc_idx) {
+    int id = arena.slots.id[proc_idx];
+    dispatches++;
+    pending_switch = warmup_penalty(proc_idx);
+    if (prev_proc_id != -1 && prev_proc_id != id) {
+        context_switches++;
+        pending_switch += switch_cost.dispatch;
+    }
+    prev_proc_id = id;
+    cache_owner_id = id;
+
+    if (arena.slots.start_time[proc_idx] == -1) {
+        arena.slots.start_time[proc_idx] = current_time;
+    }
+    return pending_switch;
+}
+
+void EventSimulator::run_until(int proc_idx, SimTime end_time) {
+#ifdef SCHED_TELEMETRY
+    // 執行中的行程與做 I/O 的行程不算在就緒佇列
+    telemetry.record_ready_queue(current_time, live_processes - blocked_processes - 1);
+    telemetry.add_busy(end_time - current_time);
+#endif
+    if (pending_switch > 0) {
+        // context switch 的成本：CPU 忙著但行程沒有進度 (被搶佔時沒付完的部分就不用付了)
+        SimTime switching = min(pending_switch, end_time - current_time);
+        if (record_gantt) {
+            gantt_timeline.append(current_time, current_time + switching, GANTT_SWITCH);
+        }
+        usage.switching += switching;
+        if (blocked_processes > 0) {
+            usage.io_active += switching;
+        }
+        pending_switch -= switching;
+        current_time += switching;
+    }
+    if (record_gantt) {
+        gantt_timeline.append(current_time, end_time, arena.slots.id[proc_idx]);
+    }
+    usage.busy += end_time - current_time;
+    if (blocked_processes > 0) {
+        usage.io_active += end_time - current_time;
+        usage.overlap += end_time - current_time;
+    }
+    arena.slots.remaining_burst_time[proc_idx] -= end_time - current_time;
+    ready_work_total -= end_time - current_time;
+    arena.slots.off_cpu_time[proc_idx] = end_time;
+    current_time = end_time;
+}
+
+void EventSimulator::idle_until(SimTime end_time) {
+    if (record_gantt) {
+        gantt_timeline.append(current_time, end_time, -1); // -1 表示CPU空閒
+    }
+#ifdef SCHED_TELEMETRY
+    telemetry.record_ready_queue(current_time, live_processes - blocked_processes);
+    telemetry.add_idle(end_time - current_time);
+#endif
+    if (blocked_processes > 0) {
+        usage.io_active += end_time - current_time;
+    }
+    current_time = end_time;
+    prev_proc_id = -1; // reset previous process ID
+}
+
+void EventSimulator::checkpoint_every(SimTime interval, CheckpointSink* sink) {
+    checkpoint_interval = interval;
+    checkpoint_sink = sink;
+    next_checkpoint_time = (current_time / interval + 1) * interval;
+}
+
+void EventSimulator::save(SnapshotWriter& out) const {
+    out.put(current_time);
+    out.put<std::uint64_t>(live_processes);
+    out.put<std::uint64_t>(blocked_processes);
+    out.put(admitted);
+    out.put(context_switches);
+    out.put(dispatches);
+    out.put(usage);
+    out.put(prev_proc_id);
+    out.put(pending_switch);
+    out.put(cache_owner_id);
+    out.put(arena.slots);
+    out.put(arena.free_slots);
+    out.put(arena.tokens);
+    out.put(arena.admission_index);
+    out.put(arena.events);
+}
+
+void EventSimulator::write_checkpoint(const SnapshotWriter& state) {
+    checkpoint_sink->write_checkpoint(current_time, state.bytes());
+    next_checkpoint_time = (current_time / checkpoint_interval + 1) * checkpoint_interval;
+}
+
+void EventSimulator::resume_from(const string& state) {
+    resume_reader.reset(new SnapshotReader(state));
+    SnapshotReader& in = *resume_reader;
+    std::uint64_t live = 0;
+    std::uint64_t blocked = 0;
+    in.get(current_time);
+    in.get(live);
+    in.get(blocked);
+    in.get(admitted);
+    in.get(context_switches);
+    in.get(dispatches);
+    in.get(usage);
+    in.get(prev_proc_id);
+    in.get(pending_switch);
+    in.get(cache_owner_id);
+    in.get(arena.slots);
+    in.get(arena.free_slots);
+    in.get(arena.tokens);
+    in.get(arena.admission_index);
+    in.get(arena.events);
+    live_processes = live;
+    blocked_processes = blocked;
+    size_t slots = arena.slots.size();
+    if (in.failed() || arena.tokens.size() != slots || arena.admission_index.size() != slots ||
+        live + arena.free_slots.size() != slots) {
+        resume_error = true;
+        arena.clear(); // 不完整的狀態不要拿來模擬
+        live_processes = 0;
+        return;
+    }
+    // ready_work 不在 snapshot 中：由不在做 I/O (burst_index 為偶數) 的行程重新計算
+    vector<bool> free_slot(slots, false);
+    for (int idx : arena.free_slots) {
+        if (idx >= 0 && (size_t)idx < slots) free_slot[idx] = true;
+    }
+    ready_work_total = 0;
+    for (size_t i = 0; i < slots; i++) {
+        if (!free_slot[i] && arena.slots.burst_index[i] % 2 == 0) ready_work_total += arena.slots.remaining_burst_time[i];
+    }
+    source.skip(admitted);
+    resuming = true;
+}
+
+bool EventSimulator::finish_resume() {
+    resuming = false;
+    if (resume_reader->failed() || !resume_reader->at_end()) resume_error = true;
+    return !resume_error;
+}
@@ -0,0 +1,260 @@
+#include "generator.h"
+#include <iostream>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cmath>
+
+using namespace std;
+
+WorkloadSpec default_workload_spec(long long num_processes, uint64_t seed) {
+    WorkloadSpec spec;
+    spec.num_processes = num_processes;
+    spec.seed = seed;
+    spec.arrival = ARRIVAL_POISSON;
+    spec.load = 0.9;
+    spec.burst_factor = 4;
+    spec.burst_fraction = 0.2;
+    spec.burst_period = 500;
+    spec.burst = BURST_PARETO;
+    spec.mean_burst = 17;
+    spec.pareto_alpha = 1.5;
+    spec.lognormal_sigma = 1;
+    spec.max_burst = 1000000;
+    spec.priorities = {PriorityWeight{1, 1}, PriorityWeight{2, 1}, PriorityWeight{3, 1}};
+    spec.deadline_fraction = 0;
+    spec.deadline_slack = 3;
+    spec.io_fraction = 0;
+    spec.mean_io_count = 2;
+    spec.mean_io_burst = 20;
+    return spec;
+}
+
+bool validate_workload_spec(const WorkloadSpec& spec) {
+    if (spec.num_processes < 0 || spec.num_processes > INT_MAX) {
+        cerr << "Error: process count must be in [0, " << INT_MAX << "]" << endl;
+        return false;
+    }
+    if (spec.load <= 0 || spec.mean_burst <= 0 || spec.max_burst <= 0 || spec.max_burst > INT_MAX) {
+        cerr << "Error: load, mean burst and max burst must be positive (max burst at most " << INT_MAX << ")" << endl;
+        return false;
+    }
+    if (spec.arrival == ARRIVAL_BURSTY &&
+        (spec.burst_fraction <= 0 || spec.burst_fraction >= 1 || spec.burst_factor < 1 ||
+         spec.burst_fraction * spec.burst_factor > 1 || spec.burst_period <= 0)) {
+        cerr << "Error: bursty arrivals need 0 < burst fraction < 1, burst factor >= 1, "
+             << "burst fraction x burst factor <= 1 and a positive burst period" << endl;
+        return false;
+    }
+    if (spec.burst == BURST_PARETO && spec.pareto_alpha <= 1) {
+        cerr << "Error: Pareto alpha must be greater than 1 (finite mean)" << endl;
+        return false;
+    }
+    if (spec.burst == BURST_LOGNORMAL && spec.lognormal_sigma < 0) {
+        cerr << "Error: lognormal sigma must not be negative" << endl;
+        return false;
+    }
+    if (spec.deadline_fraction < 0 || spec.deadline_fraction > 1 || spec.deadline_slack < 1) {
+        cerr << "Error: deadline fraction must be in [0, 1] and deadline slack must be at least 1" << endl;
+        return false;
+    }
+    if (spec.io_fraction < 0 || spec.io_fraction > 1 || spec.mean_io_count < 1 || spec.mean_io_burst <= 0) {
+        cerr << "Error: I/O fraction must be in [0, 1], mean I/O count at least 1 and mean I/O burst positive" << endl;
+        return false;
+    }
+    double total_weight = 0;
+    for (const auto& p : spec.priorities) {
+        if (p.weight < 0) {
+            cerr << "Error: priority weights must not be negative" << endl;
+            return false;
+        }
+        if (p.priority < 0 || p.priority > INT16_MAX) { // 與 trace 相同的範圍
+            cerr << "Error: priorities must be in [0, 32767]" << endl;
+            return false;
+        }
+        total_weight += p.weight;
+    }
+    if (total_weight <= 0) {
+        cerr << "Error: priority mix needs a positive total weight" << endl;
+        return false;
+    }
+    return true;
+}
+
+static const char* const ARRIVAL_PATTERN_NAMES[] = {"batch", "uniform", "poisson", "bursty"};
+static const char* const BURST_SHAPE_NAMES[] = {"uniform", "exponential", "pareto", "lognormal"};
+
+const char* arrival_pattern_name(ArrivalPattern pattern) {
+    return ARRIVAL_PATTERN_NAMES[pattern];
+}
+
+const char* burst_shape_name(BurstShape shape) {
+    return BURST_SHAPE_NAMES[shape];
+}
+
+bool parse_arrival_pattern(const string& name, ArrivalPattern& pattern) {
+    for (int i = ARRIVAL_BATCH; i <= ARRIVAL_BURSTY; i++) {
+        if (name == ARRIVAL_PATTERN_NAMES[i]) {
+            pattern = static_cast<ArrivalPattern>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parse_burst_shape(const string& name, BurstShape& shape) {
+    for (int i = BURST_UNIFORM; i <= BURST_LOGNORMAL; i++) {
+        if (name == BURST_SHAPE_NAMES[i]) {
+            shape = static_cast<BurstShape>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+WorkloadGenerator::WorkloadGenerator(const WorkloadSpec& spec)
+    : spec(spec), gen(spec.seed), produced(0), clock(0), mean_gap(spec.mean_burst / spec.load),
+      peak(false), state_end(0), spare_normal(0), has_spare_normal(false) {
+    double total_weight = 0;
+    for (const auto& p : spec.priorities) {
+        total_weight += p.weight;
+        priority_cdf.push_back(total_weight);
+    }
+    for (auto& c : priority_cdf) {
+        c /= total_weight;
+    }
+
+    if (spec.arrival == ARRIVAL_BURSTY) {
+        // 從穩態分布開始：有 burst_fraction 的機率在高峰期
+        peak = uniform() < spec.burst_fraction;
+        double period = peak ? spec.burst_period : spec.burst_period * (1 - spec.burst_fraction) / spec.burst_fraction;
+        state_end = exponential(period);
+    }
+    if (has_next()) advance_clock();
+}
+
+double WorkloadGenerator::uniform() {
+    return ((gen() >> 11) + 0.5) * (1.0 / 9007199254740992.0); // 53 bits，不會是 0 或 1
+}
+
+double WorkloadGenerator::exponential(double mean) {
+    return -log(uniform()) * mean;
+}
+
+double WorkloadGenerator::normal() {
+    if (has_spare_normal) {
+        has_spare_normal = false;
+        return spare_normal;
+    }
+    double radius = sqrt(-2 * log(uniform()));
+    double angle = 2 * 3.14159265358979323846 * uniform();
+    spare_normal = radius * sin(angle);
+    has_spare_normal = true;
+    return radius * cos(angle);
+}
+
+void WorkloadGenerator::advance_clock() {
+    if (spec.arrival == ARRIVAL_UNIFORM) {
+        clock += uniform() * 2 * mean_gap;
+    } else if (spec.arrival == ARRIVAL_POISSON) {
+        clock += exponential(mean_gap);
+    } else if (spec.arrival == ARRIVAL_BURSTY) {
+        // 指數分布沒有記憶性：間隔超過目前狀態的結尾時，直接從狀態結束的時間點換到另一個狀態重新抽
+        double mean_rate = 1 / mean_gap;
+        double peak_rate = mean_rate * spec.burst_factor;
+        double off_peak_rate = mean_rate * (1 - spec.burst_fraction * spec.burst_factor) / (1 - spec.burst_fraction);
+        while (true) {
+            double rate = peak ? peak_rate : off_peak_rate;
+            if (rate > 0) {
+                double gap = exponential(1 / rate);
+                if (clock + gap <= state_end) {
+                    clock += gap;
+                    return;
+                }
+            }
+            clock = state_end;
+            peak = !peak;
+            double period = peak ? spec.burst_period : spec.burst_period * (1 - spec.burst_fraction) / spec.burst_fraction;
+            state_end = clock + exponential(period);
+        }
+    }
+}
+
+SimTime WorkloadGenerator::sample_burst() {
+    double burst;
+    if (spec.burst == BURST_UNIFORM) {
+        SimTime low = static_cast<SimTime>(ceil(spec.mean_burst / 3));
+        SimTime high = static_cast<SimTime>(floor(spec.mean_burst * 5 / 3));
+        burst = low + floor(uniform() * (high - low + 1));
+    } else if (spec.burst == BURST_EXPONENTIAL) {
+        burst = exponential(spec.mean_burst);
+    } else if (spec.burst == BURST_PARETO) {
+        // 最小值 scale 讓平均值為 mean_burst
+        double scale = spec.mean_burst * (spec.pareto_alpha - 1) / spec.pareto_alpha;
+        burst = scale * pow(uniform(), -1 / spec.pareto_alpha);
+    } else {
+        // mu 讓平均值為 mean_burst
+        double mu = log(spec.mean_burst) - spec.lognormal_sigma * spec.lognormal_sigma / 2;
+        burst = exp(mu + spec.lognormal_sigma * normal());
+    }
+    return max<SimTime>(1, llround(min(burst, (double)spec.max_burst)));
+}
+
+int WorkloadGenerator::sample_priority() {
+    double u = uniform();
+    size_t i = lower_bound(priority_cdf.begin(), priority_cdf.end(), u) - priority_cdf.begin();
+    return spec.priorities[min(i, spec.priorities.size() - 1)].priority;
+}
+
+vector<SimTime> WorkloadGenerator::sample_io(SimTime burst) {
+    vector<SimTime> sequence;
+    if (spec.io_fraction <= 0 || uniform() >= spec.io_fraction) return sequence;
+    // 幾何分布 (>= 1)：每次有 1 / mean_io_count 的機率停止
+    long long io_count = 1;
+    if (spec.mean_io_count > 1) {
+        io_count += static_cast<long long>(floor(log(uniform()) / log(1 - 1 / spec.mean_io_count)));
+    }
+    io_count = min<long long>(io_count, burst - 1); // 每段 CPU burst 至少 1ms
+    if (io_count <= 0) return sequence;
+
+    SimTime part = burst / (io_count + 1);
+    SimTime extra = burst % (io_count + 1); // 餘數分給前面幾段
+    for (long long i = 0; i <= io_count; i++) {
+        sequence.push_back(part + (i < extra ? 1 : 0));
+        if (i < io_count) {
+            sequence.push_back(max<SimTime>(1, llround(min(exponential(spec.mean_io_burst), (double)spec.max_burst))));
+        }
+    }
+    return sequence;
+}
+
+SimTime WorkloadGenerator::sample_deadline(SimTime burst) {
+    if (spec.deadline_fraction <= 0 || uniform() >= spec.deadline_fraction) return -1;
+    return max<SimTime>(burst, llround(burst * (1 + uniform() * (spec.deadline_slack - 1))));
+}
+
+Process WorkloadGenerator::next() {
+    SimTime arrival = static_cast<SimTime>(clock);
+    SimTime burst = sample_burst();
+    int priority = sample_priority();
+    vector<SimTime> sequence = sample_io(burst);
+    SimTime io_time = 0;
+    for (size_t i = 1; i < sequence.size(); i += 2) {
+        io_time += sequence[i];
+    }
+    SimTime deadline = sample_deadline(burst + io_time);
+    Process p(static_cast<int>(produced + 1), arrival, burst, priority, deadline);
+    if (!sequence.empty()) p.set_bursts(sequence);
+    if (++produced < spec.num_processes) advance_clock();
+    return p;
+}
+
+vector<Process> generate_processes(const WorkloadSpec& spec) {
+    WorkloadGenerator generator(spec);
+    vector<Process> processes;
+    processes.reserve(spec.num_processes);
+    while (generator.has_next()) {
+        processes.push_back(generator.next());
+    }
+    return processes;
+}
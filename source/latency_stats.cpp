@@ -0,0 +1,173 @@
+#include "latency_stats.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+static const int SUB_BUCKET_BITS = 7;                         // 小於 2^7 的值精確記錄
+static const SimTime SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS; // 128
+static const SimTime SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;  // 每個 2 的次方區間切成 64 個 bucket
+
+LatencyHistogram::LatencyHistogram() : total_count(0), sum(0), min_value(0), max_value(0) {}
+
+size_t LatencyHistogram::bucket_index(SimTime value) {
+    if (value < SUB_BUCKET_COUNT) return value;
+    int exponent = 63 - __builtin_clzll(value); // value 的最高位元
+    int shift = exponent - (SUB_BUCKET_BITS - 1);
+    return SUB_BUCKET_COUNT + (exponent - SUB_BUCKET_BITS) * SUB_BUCKET_HALF + ((value >> shift) - SUB_BUCKET_HALF);
+}
+
+SimTime LatencyHistogram::bucket_value(size_t index) {
+    if ((SimTime)index < SUB_BUCKET_COUNT) return index;
+    SimTime offset = index - SUB_BUCKET_COUNT;
+    int exponent = SUB_BUCKET_BITS + offset / SUB_BUCKET_HALF;
+    int shift = exponent - (SUB_BUCKET_BITS - 1);
+    SimTime low = (offset % SUB_BUCKET_HALF + SUB_BUCKET_HALF) << shift;
+    SimTime width = SimTime(1) << shift;
+    return low + (width - 1) / 2;
+}
+
+void LatencyHistogram::record(SimTime value) {
+    if (value < 0) value = 0;
+    size_t index = bucket_index(value);
+    if (index >= buckets.size()) buckets.resize(index + 1, 0);
+    buckets[index]++;
+    if (total_count == 0 || value < min_value) min_value = value;
+    if (total_count == 0 || value > max_value) max_value = value;
+    total_count++;
+    sum += value;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.total_count == 0) return;
+    if (other.buckets.size() > buckets.size()) buckets.resize(other.buckets.size(), 0);
+    for (size_t i = 0; i < other.buckets.size(); i++) {
+        buckets[i] += other.buckets[i];
+    }
+    min_value = total_count == 0 ? other.min_value : std::min(min_value, other.min_value);
+    max_value = total_count == 0 ? other.max_value : std::max(max_value, other.max_value);
+    total_count += other.total_count;
+    sum += other.sum;
+}
+
+SimTime LatencyHistogram::percentile(double percentile) const {
+    if (total_count == 0) return 0;
+    long long rank = static_cast<long long>(ceil(percentile / 100 * total_count));
+    rank = std::max(1LL, std::min(rank, total_count));
+
+    long long seen = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            // 代表值不會超出實際記錄到的範圍
+            return std::max(min_value, std::min(max_value, bucket_value(i)));
+        }
+    }
+    return max_value;
+}
+
+void LatencyHistogram::save(SnapshotWriter& out) const {
+    out.put(buckets);
+    out.put(total_count);
+    out.put(sum);
+    out.put(min_value);
+    out.put(max_value);
+}
+
+void LatencyHistogram::load(SnapshotReader& in) {
+    in.get(buckets);
+    in.get(total_count);
+    in.get(sum);
+    in.get(min_value);
+    in.get(max_value);
+}
+
+void DeadlineStats::record(const ProcessTable& processes, size_t i) {
+    if (processes.deadline[i] == -1) return;
+    with_deadline++;
+    SimTime tardy = processes.completion_time[i] - (processes.arrival_time[i] + processes.deadline[i]);
+    if (tardy > 0) {
+        missed++;
+        tardiness.record(tardy);
+    }
+}
+
+void DeadlineStats::merge(const DeadlineStats& other) {
+    with_deadline += other.with_deadline;
+    missed += other.missed;
+    tardiness.merge(other.tardiness);
+}
+
+void DeadlineStats::save(SnapshotWriter& out) const {
+    out.put(with_deadline);
+    out.put(missed);
+    tardiness.save(out);
+}
+
+void DeadlineStats::load(SnapshotReader& in) {
+    in.get(with_deadline);
+    in.get(missed);
+    tardiness.load(in);
+}
+
+void LatencyStats::record(const ProcessTable& processes, size_t i) {
+    SimTime turnaround_time = processes.completion_time[i] - processes.arrival_time[i];
+    turnaround.record(turnaround_time);
+    waiting.record(turnaround_time - processes.burst_time[i] - processes.io_time[i]);
+    response.record(processes.start_time[i] - processes.arrival_time[i]);
+    deadlines.record(processes, i);
+}
+
+void LatencyStats::merge(const LatencyStats& other) {
+    waiting.merge(other.waiting);
+    turnaround.merge(other.turnaround);
+    response.merge(other.response);
+    deadlines.merge(other.deadlines);
+}
+
+void LatencyStats::save(SnapshotWriter& out) const {
+    waiting.save(out);
+    turnaround.save(out);
+    response.save(out);
+    deadlines.save(out);
+}
+
+void LatencyStats::load(SnapshotReader& in) {
+    waiting.load(in);
+    turnaround.load(in);
+    response.load(in);
+    deadlines.load(in);
+}
+
+static void print_histogram_row(const string& name, const LatencyHistogram& histogram) {
+    cout << setw(10) << name << " | "
+         << setw(10) << histogram.mean() << " | "
+         << setw(8) << histogram.percentile(50) << " | "
+         << setw(8) << histogram.percentile(90) << " | "
+         << setw(8) << histogram.percentile(99) << " | "
+         << setw(8) << histogram.percentile(99.9) << " | "
+         << setw(8) << histogram.max() << "\n";
+}
+
+void print_latency_stats(const LatencyStats& stats) {
+    cout << "Latency Percentiles (ms):\n";
+    cout << "    Metric |       Mean |      p50 |      p90 |      p99 |    p99.9 |      Max\n";
+    cout << "-------------------------------------------------------------------------------\n";
+    print_histogram_row("Waiting", stats.waiting);
+    print_histogram_row("Turnaround", stats.turnaround);
+    print_histogram_row("Response", stats.response);
+    cout << "-------------------------------------------------------------------------------\n";
+
+    const DeadlineStats& deadlines = stats.deadlines;
+    if (deadlines.with_deadline == 0) return;
+    cout << "Deadline Misses: " << deadlines.missed << " / " << deadlines.with_deadline
+         << " (" << deadlines.miss_rate() * 100 << "%)\n";
+    if (deadlines.missed == 0) return;
+    cout << "Tardiness of Missed Deadlines (ms):\n";
+    cout << "    Metric |       Mean |      p50 |      p90 |      p99 |    p99.9 |      Max\n";
+    cout << "-------------------------------------------------------------------------------\n";
+    print_histogram_row("Tardiness", deadlines.tardiness);
+    cout << "-------------------------------------------------------------------------------\n";
+}
@@ -1,39 +1,844 @@
-#include "process.h"
-#include "utils.h"
-#include "scheduling.h"
-#include <iostream>
-#include <iomanip>
-#include <vector>
-#include <algorithm>
-
-using namespace std;
-
-int main() {
-    int num_processes = 10;
-
-    vector<Process> initial_processes = generate_processes(num_processes);
-
-    // 為了確保每個演算法使用完全相同的初始行程狀態，每次都複製一份
-    vector<Process> processes_for_sjf = initial_processes;
-    vector<Process> processes_for_rr_priority = initial_processes;
-    vector<Process> processes_for_mlfq = initial_processes;
-    vector<Process> processes_for_custom = initial_processes;
-
-    cout << "--- Initial Processes ---\n";
-    cout << "Process ID | Arrival Time | Burst Time | Priority\n";
-    cout << "--------------------------------------------------\n";
-    for (const auto& p : initial_processes) {
-        cout << setw(10) << p.id << " | "
-             << setw(12) << p.arrival_time << " | "
-             << setw(10) << p.burst_time << " | "
-             << setw(8) << p.priority << "\n";
-    }
-    cout << "--------------------------------------------------\n";
-
-    preemptive_sjf_scheduling(processes_for_sjf); // preemptive SJF
-    rr_priority_scheduling(processes_for_rr_priority); // RR + priority
-    multilevel_feedback_queue_scheduling(processes_for_mlfq); // MLFQ
-    custom_priority_sjf_aging_scheduling(processes_for_custom); // customize
-
-    return 0;
-}
+#include "process.h"
+#include "utils.h"
+#include "scheduling.h"
+#include "sweep.h"
+#include "trace.h"
+#include "replay.h"
+#include "columnar.h"
+#include "workload.h"
+#include "multicore.h"
+#include "tuner.h"
+#include "generator.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <climits>
+#include <memory>
+#include <random>
+
+using namespace std;
+
+// 解析 "1,2,5" 或 "1-100" (也可以混用，例如 "1-10,20")
+static vector<int> parse_int_list(const string& text) {
+    vector<int> values;
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        size_t dash = item.find('-', 1);
+        if (dash == string::npos) {
+            values.push_back(atoi(item.c_str()));
+        } else {
+            int first = atoi(item.substr(0, dash).c_str());
+            int last = atoi(item.substr(dash + 1).c_str());
+            for (int v = first; v <= last; v++) {
+                values.push_back(v);
+            }
+        }
+    }
+    return values;
+}
+
+// context switch 成本的選項 (--switch-cost / --cache-penalty / --cache-decay，單位 ms)，不是這些選項時回傳 false
+static bool parse_switch_cost_option(const string& arg, const string& value, SwitchCostModel& model) {
+    if (arg == "--switch-cost") {
+        model.dispatch = atoll(value.c_str());
+    } else if (arg == "--cache-penalty") {
+        model.cache_warmup = atoll(value.c_str());
+    } else if (arg == "--cache-decay") {
+        model.cache_decay = atoll(value.c_str());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// 排程演算法參數的選項 (--quantum / --q0 / --q1 / --mlfq-boost / --threshold / --boost / --target-latency)，
+// 不是這些選項時回傳 false
+static bool parse_scheduler_param_option(const string& arg, const string& value, SchedulerParams& params) {
+    if (arg == "--quantum") {
+        params.rr.quantum = atoll(value.c_str());
+    } else if (arg == "--q0") {
+        params.mlfq.levels[0].quantum = atoll(value.c_str());
+    } else if (arg == "--q1") {
+        params.mlfq.levels[1].quantum = atoll(value.c_str());
+    } else if (arg == "--mlfq-boost") {
+        params.mlfq.boost_interval = atoll(value.c_str());
+    } else if (arg == "--threshold") {
+        params.aging.threshold = atoll(value.c_str());
+    } else if (arg == "--boost") {
+        params.aging.priority_boost = atoi(value.c_str());
+    } else if (arg == "--target-latency") {
+        params.cfs.target_latency = atoll(value.c_str());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool validate_scheduler_params(const SchedulerParams& params) {
+    // quantum 與 threshold 為 0 時事件會停在同一個時間點
+    if (params.rr.quantum <= 0 || params.mlfq.levels[0].quantum <= 0 || params.mlfq.levels[1].quantum <= 0 ||
+        params.aging.threshold <= 0 || params.cfs.target_latency <= 0) {
+        cerr << "Error: quantums, thresholds and --target-latency must be positive" << endl;
+        return false;
+    }
+    if (params.mlfq.boost_interval < 0 || params.aging.priority_boost < 0) {
+        cerr << "Error: --mlfq-boost and --boost must not be negative" << endl;
+        return false;
+    }
+    return true;
+}
+
+// sweep mode:
+//   scheduling_simulator --sweep [--seeds 1-100] [--counts 10,100,1000] [--threads N]
+//                                [--quantums 5,10] [--q1 10,20] [--thresholds 15,30] [--boosts 1,2]
+//                                [--mlfq-boost 0,50,100] [--out sweep_results.csv]
+//                                [--switch-cost 0] [--cache-penalty 0] [--cache-decay 0]
+static int run_sweep_mode(int argc, char* argv[]) {
+    SweepConfig config;
+    int num_threads = 0; // 0 表示使用所有核心
+    SwitchCostModel switch_cost = default_switch_cost_model();
+    vector<int> seeds = parse_int_list("1-10");
+    config.process_counts = parse_int_list("10,100,1000");
+    SweepGrid grid; // 沒有指定的參數使用預設值
+    string out_filename = "sweep_results.csv";
+
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Error: missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--seeds") {
+            seeds = parse_int_list(value);
+        } else if (arg == "--counts") {
+            config.process_counts = parse_int_list(value);
+        } else if (arg == "--threads") {
+            num_threads = atoi(value.c_str());
+        } else if (arg == "--quantums") {
+            grid.quantums = parse_int_list(value);
+        } else if (arg == "--q1") {
+            grid.q1_quantums = parse_int_list(value);
+        } else if (arg == "--thresholds") {
+            grid.thresholds = parse_int_list(value);
+        } else if (arg == "--boosts") {
+            grid.boosts = parse_int_list(value);
+        } else if (arg == "--mlfq-boost") {
+            grid.mlfq_boosts = parse_int_list(value);
+        } else if (arg == "--out") {
+            out_filename = value;
+        } else if (!parse_switch_cost_option(arg, value, switch_cost)) {
+            cerr << "Error: unknown option " << arg << endl;
+            return 1;
+        }
+    }
+    if (!validate_switch_cost_model(switch_cost)) return 1;
+    // 與 --tune 相同的檢查：quantum 與 threshold 為 0 時事件會停在同一個時間點，負的 boost 會降低 priority
+    for (const vector<int>* values : {&grid.quantums, &grid.q1_quantums, &grid.thresholds}) {
+        for (int v : *values) {
+            if (v <= 0) {
+                cerr << "Error: quantums and thresholds must be positive" << endl;
+                return 1;
+            }
+        }
+    }
+    for (const vector<int>* values : {&grid.boosts, &grid.mlfq_boosts}) {
+        for (int v : *values) {
+            if (v < 0) {
+                cerr << "Error: --boosts and --mlfq-boost must not be negative" << endl;
+                return 1;
+            }
+        }
+    }
+    if (num_threads < 0) {
+        cerr << "Error: --threads must not be negative" << endl;
+        return 1;
+    }
+    config.num_threads = num_threads;
+
+    for (int seed : seeds) {
+        config.seeds.push_back(seed);
+    }
+    config.algorithms = grid_sweep_algorithms(grid, switch_cost);
+
+    vector<SweepRow> rows = run_sweep(config);
+    print_sweep_table(rows);
+    save_sweep_results_to_csv(rows, out_filename);
+    return 0;
+}
+
+// replay mode: 串流讀取 trace (CSV / binary / columnar)，記憶體只跟同時存在的行程數量有關
+//   scheduling_simulator --replay trace.csv [--algo sjf|rr|mlfq|custom|cfs|edf|edf-hybrid|all] [--chunk 4096]
+//                                 [--switch-cost 0] [--cache-penalty 0] [--cache-decay 0]
+//                                 [--quantum 5] [--q0 5] [--q1 10] [--mlfq-boost 0] [--threshold 15] [--boost 1]
+//                                 [--target-latency 20]
+//                                 [--checkpoint file --every ms] | [--resume file [--at ms]]
+// --checkpoint 每隔 --every ms (模擬時間) 把狀態寫到 checkpoint 檔
+// --resume 從檔案中 --at (預設最後一個) 之前最後一個 checkpoint 繼續，可以搭配不同的參數做 what-if 比較，
+// 新的參數從 checkpoint 的時間點開始套用
+static int run_replay_mode(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "Error: missing trace file for --replay" << endl;
+        return 1;
+    }
+    string trace_filename = argv[2];
+    string algo = "all";
+    long long chunk_size = 4096;
+    SwitchCostModel switch_cost = default_switch_cost_model();
+    SchedulerParams params = default_scheduler_params();
+    string checkpoint_filename;
+    SimTime checkpoint_interval = 0;
+    string resume_filename;
+    SimTime resume_at = -1;
+
+    for (int i = 3; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Error: missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--algo") {
+            algo = value;
+        } else if (arg == "--chunk") {
+            chunk_size = atoll(value.c_str());
+        } else if (arg == "--checkpoint") {
+            checkpoint_filename = value;
+        } else if (arg == "--every") {
+            checkpoint_interval = atoll(value.c_str());
+        } else if (arg == "--resume") {
+            resume_filename = value;
+        } else if (arg == "--at") {
+            resume_at = atoll(value.c_str());
+        } else if (!parse_scheduler_param_option(arg, value, params) &&
+                   !parse_switch_cost_option(arg, value, switch_cost)) {
+            cerr << "Error: unknown option " << arg << endl;
+            return 1;
+        }
+    }
+    if (!validate_switch_cost_model(switch_cost)) return 1;
+    if (chunk_size <= 0) { // 一次讀進整個 trace 就不是串流了
+        cerr << "Error: --chunk must be positive" << endl;
+        return 1;
+    }
+    if (!validate_scheduler_params(params)) return 1;
+    if (!checkpoint_filename.empty() && !resume_filename.empty()) {
+        cerr << "Error: --checkpoint and --resume cannot be used together" << endl;
+        return 1;
+    }
+    if (!checkpoint_filename.empty() && checkpoint_interval <= 0) {
+        cerr << "Error: --checkpoint needs a positive --every" << endl;
+        return 1;
+    }
+    if (resume_at < -1) {
+        cerr << "Error: --at must not be negative" << endl;
+        return 1;
+    }
+
+    vector<string> names;
+    if (algo == "all") {
+        names = {"sjf", "rr", "mlfq", "custom", "cfs", "edf", "edf-hybrid"};
+    } else {
+        names.push_back(algo);
+    }
+
+    // 所有演算法的 checkpoint 寫在同一個檔案，以名稱區分
+    unique_ptr<CheckpointWriter> checkpoints;
+    if (!checkpoint_filename.empty()) {
+        checkpoints.reset(new CheckpointWriter(checkpoint_filename));
+        if (!checkpoints->is_open()) return 1;
+    }
+
+    for (const auto& name : names) {
+        SchedulerCore scheduler = scheduler_by_name(name, params);
+        if (!scheduler) {
+            cerr << "Error: unknown algorithm " << name << endl;
+            return 1;
+        }
+        scheduler = with_switch_cost(scheduler, switch_cost);
+        Checkpoint checkpoint;
+        if (!resume_filename.empty()) {
+            if (!find_checkpoint(resume_filename, name, resume_at, checkpoint)) return 1;
+            cout << "\nResuming " << name << " from checkpoint at " << checkpoint.time << " ms\n";
+        }
+        auto run = [&](ArrivalSource& source, ReplaySummary& summary) {
+            if (checkpoints) {
+                summary = replay_with_checkpoints(source, scheduler, name, checkpoint_interval, *checkpoints);
+                return true;
+            }
+            if (!resume_filename.empty()) return resume_replay(source, scheduler, checkpoint, summary);
+            summary = replay(source, scheduler);
+            return true;
+        };
+        ReplaySummary summary;
+        if (is_columnar_workload(trace_filename)) {
+            // columnar 檔案直接 mmap，不需要解析
+            MappedWorkload workload;
+            if (!workload.open(trace_filename)) return 1;
+            MappedWorkloadSource source(workload);
+            if (!run(source, summary)) return 1;
+        } else {
+            TraceReader reader(trace_filename, chunk_size); // 每個演算法都從頭讀一次
+            if (!reader.is_open()) return 1;
+            if (!run(reader, summary)) return 1;
+            if (reader.has_error()) return 1;
+        }
+        print_replay_summary(summary, name);
+    }
+    if (checkpoints) {
+        long long written = checkpoints->written();
+        if (!checkpoints->close()) {
+            cerr << "Error: Failed to write checkpoints to " << checkpoint_filename << endl;
+            return 1;
+        }
+        cout << "\nWrote " << written << " checkpoints to " << checkpoint_filename << "\n";
+    }
+    return 0;
+}
+
+// 產生隨機 workload 並寫成 trace 或 columnar 檔案
+//   scheduling_simulator --make-trace trace.csv [--count 10] [--seed 1] [--format csv|binary|columnar]
+static int run_make_trace_mode(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "Error: missing output file for --make-trace" << endl;
+        return 1;
+    }
+    string trace_filename = argv[2];
+    int count = 10;
+    unsigned int seed = 1;
+    string format = "csv";
+
+    for (int i = 3; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Error: missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--count") {
+            count = atoi(value.c_str());
+        } else if (arg == "--seed") {
+            seed = atoi(value.c_str());
+        } else if (arg == "--format") {
+            format = value;
+        } else {
+            cerr << "Error: unknown option " << arg << endl;
+            return 1;
+        }
+    }
+
+    vector<Process> processes = generate_processes(count, seed);
+    bool saved;
+    if (format == "csv") {
+        saved = save_processes_to_trace(processes, trace_filename, TRACE_CSV);
+    } else if (format == "binary") {
+        saved = save_processes_to_trace(processes, trace_filename, TRACE_BINARY);
+    } else if (format == "columnar") {
+        saved = save_processes_to_columnar(processes, trace_filename);
+    } else {
+        cerr << "Error: unknown trace format " << format << endl;
+        return 1;
+    }
+    return saved ? 0 : 1;
+}
+
+// 解析 priority 比例，例如 "1:0.2,2:0.3,3:0.5"
+static bool parse_priority_mix(const string& text, vector<PriorityWeight>& priorities) {
+    priorities.clear();
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        size_t colon = item.find(':');
+        if (colon == string::npos) return false;
+        // 整個欄位都必須是數字 (atoi / atof 會把 "x" 當成 0)
+        string priority_text = item.substr(0, colon);
+        string weight_text = item.substr(colon + 1);
+        char* priority_end = nullptr;
+        char* weight_end = nullptr;
+        long priority = strtol(priority_text.c_str(), &priority_end, 10);
+        double weight = strtod(weight_text.c_str(), &weight_end);
+        if (priority_text.empty() || *priority_end != '\0' || weight_text.empty() || *weight_end != '\0' ||
+            priority < INT_MIN || priority > INT_MAX) {
+            return false;
+        }
+        priorities.push_back(PriorityWeight{static_cast<int>(priority), weight});
+    }
+    return !priorities.empty();
+}
+
+// 把 generator 的行程逐筆寫入 TraceWriter 或 ColumnarWriter
+template <typename Writer>
+static bool write_generated_workload(WorkloadGenerator& generator, Writer& writer) {
+    if (!writer.is_open()) return false;
+    bool in_range = true;
+    while (generator.has_next()) {
+        Process p = generator.next();
+        // 檔案格式的欄位是 int32
+        if (p.arrival_time > INT32_MAX) {
+            cerr << "Error: process " << p.id << " arrives at " << p.arrival_time
+                 << ", beyond the int32 range of the trace format" << endl;
+            in_range = false;
+            break;
+        }
+        if (p.deadline > INT32_MAX) {
+            cerr << "Error: process " << p.id << " has deadline " << p.deadline
+                 << ", beyond the int32 range of the trace format" << endl;
+            in_range = false;
+            break;
+        }
+        if (p.burst_time > INT32_MAX) {
+            cerr << "Error: process " << p.id << " has total burst time " << p.burst_time
+                 << ", beyond the int32 range of the trace format" << endl;
+            in_range = false;
+            break;
+        }
+        writer.write(p);
+    }
+    if (!writer.close()) {
+        if (in_range) cerr << "Error: Failed to write generated workload" << endl;
+        return false;
+    }
+    return in_range;
+}
+
+// generate mode: 依 seed 即時產生 workload，直接寫成 trace 或串流給排程器 (不會把整個 workload 放進記憶體)
+//   scheduling_simulator --generate [--count 1e6] [--seed 1] [--arrivals batch|uniform|poisson|bursty] [--load 0.9]
+//                                   [--burst-factor 4] [--burst-fraction 0.2] [--burst-period 500]
+//                                   [--bursts uniform|exponential|pareto|lognormal] [--mean-burst 17]
+//                                   [--pareto-alpha 1.5] [--lognormal-sigma 1] [--max-burst 1000000]
+//                                   [--priorities 1:1,2:1,3:1] [--deadlines 0] [--deadline-slack 3]
+//                                   [--io-fraction 0] [--io-count 2] [--io-burst 20]
+//                                   [--switch-cost 0] [--cache-penalty 0] [--cache-decay 0] (只用於 --algo)
+//                                   [--out file [--format csv|binary|columnar] | --algo sjf|rr|mlfq|custom|cfs|edf|edf-hybrid|all]
+static int run_generate_mode(int argc, char* argv[]) {
+    WorkloadSpec spec = default_workload_spec(1000000, 1);
+    string out_filename;
+    string format = "csv";
+    string algo = "all";
+    SwitchCostModel switch_cost = default_switch_cost_model();
+
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Error: missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--count") {
+            spec.num_processes = llround(atof(value.c_str())); // 也接受 1e8 這種寫法
+        } else if (arg == "--seed") {
+            spec.seed = strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--arrivals") {
+            if (!parse_arrival_pattern(value, spec.arrival)) {
+                cerr << "Error: unknown arrival distribution " << value << endl;
+                return 1;
+            }
+        } else if (arg == "--load") {
+            spec.load = atof(value.c_str());
+        } else if (arg == "--burst-factor") {
+            spec.burst_factor = atof(value.c_str());
+        } else if (arg == "--burst-fraction") {
+            spec.burst_fraction = atof(value.c_str());
+        } else if (arg == "--burst-period") {
+            spec.burst_period = atof(value.c_str());
+        } else if (arg == "--bursts") {
+            if (!parse_burst_shape(value, spec.burst)) {
+                cerr << "Error: unknown burst distribution " << value << endl;
+                return 1;
+            }
+        } else if (arg == "--mean-burst") {
+            spec.mean_burst = atof(value.c_str());
+        } else if (arg == "--pareto-alpha") {
+            spec.pareto_alpha = atof(value.c_str());
+        } else if (arg == "--lognormal-sigma") {
+            spec.lognormal_sigma = atof(value.c_str());
+        } else if (arg == "--max-burst") {
+            spec.max_burst = atoll(value.c_str());
+        } else if (arg == "--priorities") {
+            if (!parse_priority_mix(value, spec.priorities)) {
+                cerr << "Error: priority mix must look like 1:0.2,2:0.3,3:0.5" << endl;
+                return 1;
+            }
+        } else if (arg == "--deadlines") {
+            spec.deadline_fraction = atof(value.c_str());
+        } else if (arg == "--deadline-slack") {
+            spec.deadline_slack = atof(value.c_str());
+        } else if (arg == "--io-fraction") {
+            spec.io_fraction = atof(value.c_str());
+        } else if (arg == "--io-count") {
+            spec.mean_io_count = atof(value.c_str());
+        } else if (arg == "--io-burst") {
+            spec.mean_io_burst = atof(value.c_str());
+        } else if (arg == "--out") {
+            out_filename = value;
+        } else if (arg == "--format") {
+            format = value;
+        } else if (arg == "--algo") {
+            algo = value;
+        } else if (!parse_switch_cost_option(arg, value, switch_cost)) {
+            cerr << "Error: unknown option " << arg << endl;
+            return 1;
+        }
+    }
+    if (!validate_workload_spec(spec) || !validate_switch_cost_model(switch_cost)) return 1;
+
+    if (out_filename.empty()) {
+        vector<string> names;
+        if (algo == "all") {
+            names = {"sjf", "rr", "mlfq", "custom", "cfs", "edf", "edf-hybrid"};
+        } else {
+            names.push_back(algo);
+        }
+        for (const auto& name : names) {
+            SchedulerCore scheduler = scheduler_by_name(name);
+            if (!scheduler) {
+                cerr << "Error: unknown algorithm " << name << endl;
+                return 1;
+            }
+            WorkloadGenerator generator(spec); // 每個演算法都用同一個 seed 重新產生
+            print_replay_summary(replay(generator, with_switch_cost(scheduler, switch_cost)), name);
+        }
+        return 0;
+    }
+
+    WorkloadGenerator generator(spec);
+    bool with_deadlines = spec.deadline_fraction > 0;
+    bool with_io = spec.io_fraction > 0;
+    bool saved;
+    if (format == "csv" || format == "binary") {
+        TraceWriter writer(out_filename, format == "csv" ? TRACE_CSV : TRACE_BINARY, with_deadlines, with_io);
+        saved = write_generated_workload(generator, writer);
+    } else if (format == "columnar") {
+        if (with_io) {
+            cerr << "Error: columnar workloads have fixed-width columns and cannot hold I/O bursts, use csv or binary" << endl;
+            return 1;
+        }
+        ColumnarWriter writer(out_filename, spec.num_processes, with_deadlines);
+        saved = write_generated_workload(generator, writer);
+    } else {
+        cerr << "Error: unknown trace format " << format << endl;
+        return 1;
+    }
+    if (!saved) return 1;
+    cout << "Generated " << generator.get_produced() << " processes into " << out_filename << endl;
+    return 0;
+}
+
+// multi-core mode: N 個核心，比較不同的 load balancing 方式
+//   scheduling_simulator --multicore [--cores 8] [--balance global|steal|affinity|all]
+//                                    [--policy sjf|rr|mlfq|custom|cfs|edf|edf-hybrid] [--steal-threshold 2]
+//                                    [--count 1000] [--seed 1] [--trace file] [--threads 1]
+//                                    [--switch-cost 0] [--cache-penalty 0] [--cache-decay 0]
+//                                    [--quantum 5] [--q0 5] [--q1 10] [--mlfq-boost 0] [--threshold 15] [--boost 1]
+//                                    [--target-latency 20]
+// 每個核心以 --policy 的演算法排程 (參數與 --replay 相同)，srtf 是 sjf 的別名
+static int run_multicore_mode(int argc, char* argv[]) {
+    MultiCoreConfig config = default_multicore_config(8);
+    string balance = "all";
+    int count = 1000;
+    unsigned int seed = 1;
+    string trace_filename;
+
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Error: missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--cores") {
+            config.num_cores = atoi(value.c_str());
+        } else if (arg == "--balance") {
+            balance = value;
+        } else if (arg == "--policy") {
+            if (!is_multicore_policy(value)) {
+                cerr << "Error: unknown core policy " << value << endl;
+                return 1;
+            }
+            config.policy = value;
+        } else if (arg == "--steal-threshold") {
+            config.steal_threshold = atoi(value.c_str());
+        } else if (arg == "--count") {
+            count = atoi(value.c_str());
+        } else if (arg == "--seed") {
+            seed = atoi(value.c_str());
+        } else if (arg == "--trace") {
+            trace_filename = value;
+        } else if (arg == "--threads") {
+            config.num_threads = atoi(value.c_str());
+        } else if (!parse_scheduler_param_option(arg, value, config.params) &&
+                   !parse_switch_cost_option(arg, value, config.switch_cost)) {
+            cerr << "Error: unknown option " << arg << endl;
+            return 1;
+        }
+    }
+    if (config.num_cores <= 0 || config.num_threads <= 0) {
+        cerr << "Error: --cores and --threads must be positive" << endl;
+        return 1;
+    }
+    if (!validate_switch_cost_model(config.switch_cost) || !validate_scheduler_params(config.params)) return 1;
+    if (config.steal_threshold < 1) { // 0 或負數與 1 的效果相同，應該是打錯了
+        cerr << "Error: --steal-threshold must be at least 1" << endl;
+        return 1;
+    }
+
+    vector<LoadBalancing> modes;
+    if (balance == "global" || balance == "all") modes.push_back(BALANCE_GLOBAL);
+    if (balance == "steal" || balance == "all") modes.push_back(BALANCE_WORK_STEALING);
+    if (balance == "affinity" || balance == "all") modes.push_back(BALANCE_AFFINITY);
+    if (modes.empty()) {
+        cerr << "Error: unknown load balancing mode " << balance << endl;
+        return 1;
+    }
+
+    Workload workload;
+    if (trace_filename.empty()) {
+        WorkloadSpec spec = default_workload_spec(count, seed);
+        spec.load *= config.num_cores; // 每個核心的負載與單核心的預設相同
+        workload = Workload(generate_processes(spec));
+    }
+    for (LoadBalancing mode : modes) {
+        config.balancing = mode;
+        MultiCoreResult result;
+        if (trace_filename.empty()) {
+            WorkloadSource source(workload);
+            result = run_multicore(source, config);
+        } else if (is_columnar_workload(trace_filename)) {
+            MappedWorkload mapped;
+            if (!mapped.open(trace_filename)) return 1;
+            MappedWorkloadSource source(mapped);
+            result = run_multicore(source, config);
+        } else {
+            TraceReader reader(trace_filename); // 每個模式都從頭讀一次
+            if (!reader.is_open()) return 1;
+            result = run_multicore(reader, config);
+            if (reader.has_error()) return 1;
+        }
+        print_multicore_result(result, config);
+    }
+    return 0;
+}
+
+// 把整個 trace (CSV / binary / columnar) 讀進記憶體
+static bool load_trace_workload(const string& filename, Workload& workload) {
+    vector<Process> processes;
+    if (is_columnar_workload(filename)) {
+        MappedWorkload mapped;
+        if (!mapped.open(filename)) return false;
+        MappedWorkloadSource source(mapped);
+        while (source.has_next()) processes.push_back(source.next());
+    } else {
+        TraceReader reader(filename);
+        if (!reader.is_open()) return false;
+        while (reader.has_next()) processes.push_back(reader.next());
+        if (reader.has_error()) return false;
+    }
+    workload = Workload(processes);
+    return true;
+}
+
+// tune mode: 對一組 workload 搜尋排程參數，objective 為 waiting time 百分位數 + context switch 懲罰
+//   scheduling_simulator --tune rr|mlfq|custom [--seeds 1-10] [--count 1000] [--trace file (可重複)]
+//                               [--percentile 99] [--switch-penalty 1] [--threads N]
+//                               [--quantums 1-20] [--q1 5,10,20,40,80] [--thresholds 5,10,15,20,30,50] [--boosts 1,2,3]
+//                               [--top 10] [--out tuning_results.csv]
+//                               [--switch-cost 0] [--cache-penalty 0] [--cache-decay 0]
+static int run_tune_mode(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "Error: missing algorithm for --tune (rr|mlfq|custom)" << endl;
+        return 1;
+    }
+    TunerConfig config;
+    string algo = argv[2];
+    if (algo == "rr") {
+        config.algorithm = TUNE_RR_PRIORITY;
+    } else if (algo == "mlfq") {
+        config.algorithm = TUNE_MLFQ;
+    } else if (algo == "custom") {
+        config.algorithm = TUNE_CUSTOM;
+    } else {
+        cerr << "Error: unknown algorithm " << algo << " for --tune" << endl;
+        return 1;
+    }
+    config.objective = TuningObjective{99, 1};
+    config.switch_cost = default_switch_cost_model();
+    int num_threads = 0; // 0 表示使用所有核心
+    vector<int> seeds = parse_int_list("1-10");
+    int count = 1000;
+    vector<string> trace_filenames;
+    vector<int> quantums = parse_int_list("1-20");
+    vector<int> q1_quantums = parse_int_list("5,10,20,40,80");
+    vector<int> thresholds = parse_int_list("5,10,15,20,30,50");
+    vector<int> boosts = parse_int_list("1,2,3");
+    size_t top = 10;
+    string out_filename = "tuning_results.csv";
+
+    for (int i = 3; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Error: missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--seeds") {
+            seeds = parse_int_list(value);
+        } else if (arg == "--count") {
+            count = atoi(value.c_str());
+        } else if (arg == "--trace") {
+            trace_filenames.push_back(value);
+        } else if (arg == "--percentile") {
+            config.objective.waiting_percentile = atof(value.c_str());
+        } else if (arg == "--switch-penalty") {
+            config.objective.context_switch_penalty = atof(value.c_str());
+        } else if (arg == "--threads") {
+            num_threads = atoi(value.c_str());
+        } else if (arg == "--quantums") {
+            quantums = parse_int_list(value);
+        } else if (arg == "--q1") {
+            q1_quantums = parse_int_list(value);
+        } else if (arg == "--thresholds") {
+            thresholds = parse_int_list(value);
+        } else if (arg == "--boosts") {
+            boosts = parse_int_list(value);
+        } else if (arg == "--top") {
+            top = atoi(value.c_str());
+        } else if (arg == "--out") {
+            out_filename = value;
+        } else if (!parse_switch_cost_option(arg, value, config.switch_cost)) {
+            cerr << "Error: unknown option " << arg << endl;
+            return 1;
+        }
+    }
+    if (!validate_switch_cost_model(config.switch_cost)) return 1;
+    if (config.objective.context_switch_penalty < 0 || config.objective.waiting_percentile < 0 ||
+        config.objective.waiting_percentile > 100) {
+        cerr << "Error: --percentile must be in [0, 100] and --switch-penalty must not be negative" << endl;
+        return 1;
+    }
+    if (num_threads < 0) {
+        cerr << "Error: --threads must not be negative" << endl;
+        return 1;
+    }
+    config.num_threads = num_threads;
+    // quantum 與 threshold 為 0 時事件會停在同一個時間點
+    for (const vector<int>* values : {&quantums, &q1_quantums, &thresholds}) {
+        for (int v : *values) {
+            if (v <= 0) {
+                cerr << "Error: quantums and thresholds must be positive" << endl;
+                return 1;
+            }
+        }
+    }
+    // 負的 boost 會降低 priority (與 replay 的 --boost 相同的檢查)
+    for (int boost : boosts) {
+        if (boost < 0) {
+            cerr << "Error: --boosts must not be negative" << endl;
+            return 1;
+        }
+    }
+
+    if (config.algorithm == TUNE_RR_PRIORITY) {
+        config.candidates = rr_priority_grid(quantums);
+    } else if (config.algorithm == TUNE_MLFQ) {
+        config.candidates = mlfq_grid(quantums, q1_quantums);
+    } else {
+        config.candidates = aging_grid(thresholds, boosts);
+    }
+    if (config.candidates.empty()) {
+        cerr << "Error: empty parameter grid" << endl;
+        return 1;
+    }
+
+    vector<Workload> workloads;
+    for (const auto& filename : trace_filenames) {
+        workloads.push_back(Workload());
+        if (!load_trace_workload(filename, workloads.back())) return 1;
+    }
+    if (trace_filenames.empty()) {
+        for (int seed : seeds) {
+            workloads.push_back(Workload(generate_processes(default_workload_spec(count, seed))));
+        }
+    }
+
+    vector<TuningResult> results = run_tuner(config, workloads);
+    print_tuning_results(config, results, top);
+    save_tuning_results_to_csv(config, results, out_filename);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--sweep") {
+        return run_sweep_mode(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--replay") {
+        return run_replay_mode(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--make-trace") {
+        return run_make_trace_mode(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--generate") {
+        return run_generate_mode(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--multicore") {
+        return run_multicore_mode(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--tune") {
+        return run_tune_mode(argc, argv);
+    }
+
+    // 預設執行：作業規定的 10 個隨機行程，--seed 可以重現同一組 workload
+    //   scheduling_simulator [--seed N] [--gantt-format csv|binary]
+    int num_processes = 10;
+    unsigned int seed = random_device()();
+    GanttFormat gantt_format = GANTT_CSV;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            seed = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--gantt-format" && i + 1 < argc) {
+            string value = argv[++i];
+            if (value == "csv") {
+                gantt_format = GANTT_CSV;
+            } else if (value == "binary") {
+                gantt_format = GANTT_BINARY;
+            } else {
+                cerr << "Error: unknown Gantt chart format " << value << endl;
+                return 1;
+            }
+        } else {
+            cerr << "Error: unknown option " << arg << endl;
+            return 1;
+        }
+    }
+
+    vector<Process> initial_processes = generate_processes(num_processes, seed);
+
+    // 每個演算法都讀同一份不可變的 workload，執行時的狀態各自獨立，不需要複製
+    Workload workload(initial_processes);
+
+    cout << "--- Initial Processes (seed " << seed << ") ---\n";
+    cout << "Process ID | Arrival Time | Burst Time | Priority\n";
+    cout << "--------------------------------------------------\n";
+    for (const auto& p : initial_processes) {
+        cout << setw(10) << p.id << " | "
+             << setw(12) << p.arrival_time << " | "
+             << setw(10) << p.burst_time << " | "
+             << setw(8) << p.priority << "\n";
+    }
+    cout << "--------------------------------------------------\n";
+
+    preemptive_sjf_scheduling(workload, gantt_format); // preemptive SJF
+    rr_priority_scheduling(workload, default_rr_priority_config(), gantt_format); // RR + priority
+    multilevel_feedback_queue_scheduling(workload, default_mlfq_config(), gantt_format); // MLFQ
+    custom_priority_sjf_aging_scheduling(workload, default_aging_config(), gantt_format); // customize
+    cfs_scheduling(workload, default_cfs_config(), gantt_format); // CFS
+
+    return 0;
+}
@@ -0,0 +1,511 @@
+#include "multicore.h"
+#include "policy_engine.h"
+#include "ready_queues.h"
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <limits>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+MultiCoreConfig default_multicore_config(int num_cores) {
+    return MultiCoreConfig{num_cores, BALANCE_WORK_STEALING, "rr", default_scheduler_params(),
+                           default_switch_cost_model(), 2, 1};
+}
+
+// srtf 是 sjf (preemptive SJF) 的別名
+bool is_multicore_policy(const string& policy) {
+    return policy == "sjf" || policy == "srtf" || policy == "rr" || policy == "mlfq" || policy == "custom" ||
+           policy == "cfs" || policy == "edf" || policy == "edf-hybrid";
+}
+
+const char* load_balancing_name(LoadBalancing balancing) {
+    switch (balancing) {
+    case BALANCE_GLOBAL: return "global queue";
+    case BALANCE_WORK_STEALING: return "work stealing";
+    case BALANCE_AFFINITY: return "affinity";
+    }
+    return "unknown";
+}
+
+static const SimTime NO_EVENT = numeric_limits<SimTime>::max();
+// 一個時間窗口最多先讀入的新行程數，避免很長的窗口把整個 trace 讀進記憶體
+static const size_t WINDOW_ARRIVAL_LIMIT = 1 << 16;
+
+// 核心的 EventSimulator 的 arrival source：分配到這個核心的新行程與偷來的行程，依放進來的順序 admit
+// ready_time 是可以 admit 的時間 (新行程為 arrival time，偷來的行程為偷的時間)，行程本身的 arrival time 不變
+class CoreInbox : public ArrivalSource {
+public:
+    CoreInbox() : head(0) {}
+
+    bool has_next() override { return head < ready_time.size(); }
+    SimTime peek_arrival_time() override { return ready_time[head]; }
+    Process next() override {
+        Process p = rows.row(head);
+        pop();
+        return p;
+    }
+    void next_into(ProcessTable& table, size_t slot) override {
+        table.assign(slot, rows, head);
+        pop();
+    }
+
+    size_t pending() const { return ready_time.size() - head; }
+    const ProcessTable& table() const { return rows; }
+    size_t front() const { return head; }
+
+    void push(ArrivalSource& source) {
+        size_t row = rows.size();
+        rows.resize(row + 1);
+        source.next_into(rows, row);
+        ready_time.push_back(rows.arrival_time[row]);
+    }
+    // 從其他核心移過來的行程：now 起可以執行，這個核心的 cache 是冷的
+    void push_migrated(const ProcessTable& from, size_t row, SimTime now) {
+        rows.append(from, row);
+        rows.off_cpu_time.back() = -1;
+        ready_time.push_back(now);
+    }
+    void pop() {
+        if (++head == ready_time.size()) { // 全部 admit 之後重複使用空間
+            rows.clear();
+            ready_time.clear();
+            head = 0;
+        }
+    }
+
+private:
+    ProcessTable rows;
+    vector<SimTime> ready_time;
+    size_t head;
+};
+
+// 一個核心：自己的 EventSimulator 與單一 CPU 的排程引擎，統計只由推進這個核心的 thread 寫入
+class CoreScheduler {
+public:
+    explicit CoreScheduler(const SwitchCostModel& switch_cost)
+        : sim(inbox, [this](const ProcessTable& table, int idx) { record(table, idx); }, false),
+          completed_processes(0), makespan(0), migrations_in(0), steals(0) {
+        sim.set_switch_cost(switch_cost);
+    }
+    virtual ~CoreScheduler() {}
+
+    // 與 PolicyEngine 相同
+    virtual void round() = 0;
+    virtual SimTime next_round() = 0;
+    virtual void advance(SimTime end) = 0;
+    virtual bool idle() const = 0;
+    virtual int steal() = 0;
+
+    // 可以被偷的行程：就緒佇列中等待的行程與還沒 admit 的行程
+    size_t waiting() const { return sim.ready_count() - (idle() ? 0 : 1) + inbox.pending(); }
+    size_t load() const { return sim.ready_count() + inbox.pending(); }
+
+    CoreInbox inbox;
+    EventSimulator sim;
+    long long completed_processes;
+    SimTime makespan;
+    LatencyStats latency;
+    long long migrations_in;
+    long long steals;
+
+private:
+    void record(const ProcessTable& table, int idx) {
+        completed_processes++;
+        makespan = max(makespan, table.completion_time[idx]);
+        latency.record(table, idx);
+    }
+};
+
+template <typename ReadyQueue, typename QuantumPolicy, typename AgingPolicy>
+class PolicyCore : public CoreScheduler {
+public:
+    template <typename... QueueArgs>
+    PolicyCore(const SwitchCostModel& switch_cost, const QuantumPolicy& quantum, const AgingPolicy& aging,
+               const QueueArgs&... queue_args)
+        : CoreScheduler(switch_cost), ready(sim, queue_args...), quantum(quantum), aging(aging),
+          engine(sim, ready, this->quantum, this->aging) {}
+
+    void round() override { engine.round(); }
+    SimTime next_round() override { return engine.next_round(); }
+    void advance(SimTime end) override { engine.advance(end); }
+    bool idle() const override { return engine.idle(); }
+    int steal() override { return engine.steal(); }
+
+private:
+    ReadyQueue ready;
+    QuantumPolicy quantum;
+    AgingPolicy aging;
+    PolicyEngine<ReadyQueue, QuantumPolicy, AgingPolicy> engine;
+};
+
+// 與 scheduler_by_name 相同的組合，params 必須活得比核心久 (LevelQuantum / FairSlice 只保留參考)
+static unique_ptr<CoreScheduler> make_core(const string& policy, const SchedulerParams& params,
+                                           const SwitchCostModel& switch_cost) {
+    if (policy == "sjf" || policy == "srtf") {
+        return unique_ptr<CoreScheduler>(new PolicyCore<ShortestRemainingQueue, RunToCompletion, NoAging>(
+            switch_cost, RunToCompletion(), NoAging()));
+    }
+    if (policy == "rr") {
+        return unique_ptr<CoreScheduler>(new PolicyCore<PriorityRoundRobinQueue, FixedQuantum, NoAging>(
+            switch_cost, FixedQuantum{params.rr.quantum}, NoAging()));
+    }
+    if (policy == "mlfq") {
+        return unique_ptr<CoreScheduler>(new PolicyCore<FeedbackQueue, LevelQuantum, PeriodicBoost>(
+            switch_cost, LevelQuantum{params.mlfq}, PeriodicBoost(params.mlfq.boost_interval),
+            (int)params.mlfq.levels.size()));
+    }
+    if (policy == "custom") {
+        return unique_ptr<CoreScheduler>(new PolicyCore<PriorityShortestQueue, RunToCompletion, ThresholdAging>(
+            switch_cost, RunToCompletion(), ThresholdAging(params.aging)));
+    }
+    if (policy == "cfs") {
+        return unique_ptr<CoreScheduler>(new PolicyCore<FairQueue, FairSlice, NoAging>(
+            switch_cost, FairSlice{params.cfs}, NoAging(), params.cfs));
+    }
+    EDFConfig edf = policy == "edf-hybrid" ? EDFConfig{true} : default_edf_config();
+    return unique_ptr<CoreScheduler>(new PolicyCore<DeadlineQueue, RunToCompletion, NoAging>(
+        switch_cost, RunToCompletion(), NoAging(), edf));
+}
+
+class MultiCoreSimulator {
+public:
+    MultiCoreSimulator(ArrivalSource& source, const MultiCoreConfig& config);
+    MultiCoreResult run();
+
+private:
+    int place();
+    void admit_arrival(); // 從 source 取出下一個行程放到 place() 的核心
+    void steal(int thief);
+    void step(SimTime time);
+    SimTime next_event_time();
+    void advance_shard(int shard, SimTime end);
+    SimTime window_end();
+    void run_window(SimTime end);
+    void worker_loop(int shard);
+
+    ArrivalSource& source;
+    MultiCoreConfig config; // 核心的排程引擎參考其中的 params
+    vector<unique_ptr<CoreScheduler>> cores;
+    vector<SimTime> next_rounds; // 各核心的 next_round()，推進到這個時間的核心在該時間點要 round()
+    vector<int> shard_begin;     // shard s 是核心 [shard_begin[s], shard_begin[s + 1])，循序模擬時只有一個 shard
+
+    SimTime now;
+    int next_placement_core;
+    bool io_seen; // 有沒有分配過有 I/O burst 的行程
+
+    // 平行模式：shard 0 由呼叫 run() 的 thread 負責，其他 shard 各有一個 worker thread
+    vector<thread> workers;
+    mutex window_mutex;
+    condition_variable window_started;
+    condition_variable window_finished;
+    long long window_generation;
+    SimTime current_window_end;
+    int pending_shards;
+    bool stopping;
+};
+
+MultiCoreSimulator::MultiCoreSimulator(ArrivalSource& source, const MultiCoreConfig& config)
+    : source(source), config(config), now(0), next_placement_core(0), io_seen(false), window_generation(0),
+      current_window_end(0), pending_shards(0), stopping(false) {
+    int num_cores = max(1, config.num_cores);
+    for (int c = 0; c < num_cores; c++) {
+        cores.push_back(make_core(this->config.policy, this->config.params, config.switch_cost));
+    }
+    next_rounds.assign(num_cores, -1);
+    int num_shards = max(1, min(config.num_threads, num_cores));
+    for (int s = 0; s <= num_shards; s++) {
+        shard_begin.push_back(s * num_cores / num_shards);
+    }
+}
+
+// 新行程放到哪個核心
+int MultiCoreSimulator::place() {
+    if (config.balancing == BALANCE_WORK_STEALING) {
+        int core = next_placement_core;
+        next_placement_core = (next_placement_core + 1) % cores.size();
+        return core;
+    }
+    // affinity / global: 負載 (就緒的行程 + 還沒 admit 的行程) 最輕的核心
+    int best = 0;
+    size_t best_load = 0;
+    for (size_t c = 0; c < cores.size(); c++) {
+        size_t load = cores[c]->load();
+        if (c == 0 || load < best_load) {
+            best = c;
+            best_load = load;
+        }
+    }
+    return best;
+}
+
+void MultiCoreSimulator::admit_arrival() {
+    CoreInbox& inbox = cores[place()]->inbox;
+    inbox.push(source);
+    if (inbox.table().bursts[inbox.table().size() - 1].size() > 1) io_seen = true;
+}
+
+// 空閒的核心從等待行程最多的核心偷一個：先偷還沒 admit 的行程，否則偷就緒佇列最前面的行程
+// 偷來的行程放進 thief 的 inbox，thief 立刻 round() 讓它 admit 並開始執行
+void MultiCoreSimulator::steal(int thief) {
+    int victim = -1;
+    size_t most_waiting = 0;
+    for (size_t c = 0; c < cores.size(); c++) {
+        if ((int)c == thief) continue;
+        size_t waiting = cores[c]->waiting();
+        if (waiting > most_waiting) {
+            victim = c;
+            most_waiting = waiting;
+        }
+    }
+    size_t threshold = config.balancing == BALANCE_AFFINITY ? config.steal_threshold : 1;
+    if (victim == -1 || most_waiting < threshold) return;
+
+    CoreScheduler& from = *cores[victim];
+    CoreScheduler& to = *cores[thief];
+    bool started;
+    if (from.inbox.pending() > 0) {
+        started = from.inbox.table().start_time[from.inbox.front()] != -1;
+        to.inbox.push_migrated(from.inbox.table(), from.inbox.front(), now);
+        from.inbox.pop();
+    } else {
+        int idx = from.steal();
+        started = from.sim.get_processes().start_time[idx] != -1;
+        to.inbox.push_migrated(from.sim.get_processes(), idx, now);
+        from.sim.release(idx);
+    }
+    if (started) to.migrations_in++;
+    to.steals++;
+    to.round();
+}
+
+// 所有核心在 time 這個時間點的一步 (可能有跨核心的互動，由一個 thread 執行)
+// 核心只在自己需要 round() 的時間點執行 round()，與單一 CPU 的模擬相同
+void MultiCoreSimulator::step(SimTime time) {
+    while (source.has_next() && source.peek_arrival_time() <= time) {
+        admit_arrival();
+    }
+    for (size_t c = 0; c < cores.size(); c++) {
+        if (next_rounds[c] == time || cores[c]->next_round() == time) {
+            cores[c]->round();
+        }
+    }
+    for (size_t c = 0; c < cores.size(); c++) {
+        if (cores[c]->idle()) steal(c);
+    }
+}
+
+// 下一個需要處理的時間 (任一核心的 next_round() 或新行程到達)，同時更新 next_rounds
+SimTime MultiCoreSimulator::next_event_time() {
+    SimTime next_time = source.has_next() ? source.peek_arrival_time() : NO_EVENT;
+    for (size_t c = 0; c < cores.size(); c++) {
+        next_rounds[c] = cores[c]->next_round();
+        if (next_rounds[c] != -1) next_time = min(next_time, next_rounds[c]);
+    }
+    return next_time;
+}
+
+// 窗口內 shard 的核心各自以單一 CPU 的方式推進到 end 之前 (確定不會有跨核心的互動)
+void MultiCoreSimulator::advance_shard(int shard, SimTime end) {
+    for (int c = shard_begin[shard]; c < shard_begin[shard + 1]; c++) {
+        CoreScheduler& core = *cores[c];
+        SimTime next_time;
+        while ((next_time = core.next_round()) != -1 && next_time < end) {
+            core.advance(next_time);
+            core.round();
+        }
+    }
+}
+
+// 剛執行完 step(now) 之後，最早可能發生跨核心互動的時間 (保守估計)：
+// - 核心的等待行程數只有在新行程到達或 I/O 結束時會增加 (搶佔、quantum 用完、aging 都是一換一)
+// - 有核心空閒時 (代表沒有任何核心的等待行程數達到 threshold)，下一次偷行程最早在下一個新行程到達時，
+//   或是 I/O 結束時：做 I/O 的行程最早在核心的下一個事件結束 CPU burst，所以有 I/O 時窗口只到最早的 next_round()
+// - 沒有核心空閒時，核心最早在 now + 就緒行程這個 CPU burst 剩餘時間的總和 之後才會空閒
+// - affinity / global 的新行程依照所有核心的負載分配，每個新行程都要同步
+SimTime MultiCoreSimulator::window_end() {
+    SimTime next_arrival = source.has_next() ? source.peek_arrival_time() : NO_EVENT;
+    bool idle_core = false;
+    SimTime earliest_idle = NO_EVENT;
+    SimTime earliest_round = NO_EVENT;
+    for (size_t c = 0; c < cores.size(); c++) {
+        if (next_rounds[c] != -1) earliest_round = min(earliest_round, next_rounds[c]);
+        if (cores[c]->idle()) {
+            idle_core = true;
+        } else {
+            earliest_idle = min(earliest_idle, now + cores[c]->sim.ready_work());
+        }
+    }
+    SimTime end = earliest_idle;
+    if (idle_core) {
+        end = io_seen ? min(next_arrival, earliest_round) : next_arrival;
+    }
+    if (config.balancing != BALANCE_WORK_STEALING) {
+        end = min(end, next_arrival);
+    }
+    return end;
+}
+
+// 先把窗口內的新行程分配到各核心 (只有 work stealing：分配與負載無關)，再讓所有 shard 平行推進到 end 之前
+void MultiCoreSimulator::run_window(SimTime end) {
+    size_t buffered = 0;
+    SimTime last_arrival = -1;
+    while (source.has_next() && source.peek_arrival_time() < end) {
+        SimTime arrival = source.peek_arrival_time();
+        if (buffered >= WINDOW_ARRIVAL_LIMIT && arrival > last_arrival) {
+            end = arrival; // 同一時間到達的行程必須在同一個窗口
+            break;
+        }
+        admit_arrival();
+        buffered++;
+        last_arrival = arrival;
+    }
+
+    int active = 0;
+    for (size_t s = 0; s + 1 < shard_begin.size(); s++) {
+        for (int c = shard_begin[s]; c < shard_begin[s + 1]; c++) {
+            SimTime next_time = cores[c]->next_round();
+            if (next_time != -1 && next_time < end) {
+                active++;
+                break;
+            }
+        }
+    }
+    int num_shards = shard_begin.size() - 1;
+    if (active <= 1) {
+        // 只有一個 shard 有事件時不需要叫醒 worker
+        for (int s = 0; s < num_shards; s++) {
+            advance_shard(s, end);
+        }
+        return;
+    }
+    {
+        lock_guard<mutex> lock(window_mutex);
+        current_window_end = end;
+        pending_shards = num_shards - 1;
+        window_generation++;
+    }
+    window_started.notify_all();
+    advance_shard(0, end);
+    unique_lock<mutex> lock(window_mutex);
+    window_finished.wait(lock, [this] { return pending_shards == 0; });
+}
+
+void MultiCoreSimulator::worker_loop(int shard) {
+    long long seen_generation = 0;
+    while (true) {
+        SimTime end;
+        {
+            unique_lock<mutex> lock(window_mutex);
+            window_started.wait(lock, [&] { return stopping || window_generation != seen_generation; });
+            if (stopping) return;
+            seen_generation = window_generation;
+            end = current_window_end;
+        }
+        advance_shard(shard, end);
+        lock_guard<mutex> lock(window_mutex);
+        if (--pending_shards == 0) {
+            window_finished.notify_one();
+        }
+    }
+}
+
+MultiCoreResult MultiCoreSimulator::run() {
+    int num_shards = shard_begin.size() - 1;
+    for (int s = 1; s < num_shards; s++) {
+        workers.emplace_back(&MultiCoreSimulator::worker_loop, this, s);
+    }
+
+    while (true) {
+        step(now);
+        SimTime next_time = next_event_time();
+        if (next_time != NO_EVENT && num_shards > 1) {
+            SimTime end = window_end();
+            if (next_time < end) {
+                run_window(end);
+                next_time = next_event_time();
+            }
+        }
+        // 直接跳到下一個事件，所有核心一起推進 (不超過任何核心的 next_round())
+        if (next_time == NO_EVENT) break;
+        for (auto& core : cores) {
+            core->advance(next_time);
+        }
+        now = next_time;
+    }
+
+    {
+        lock_guard<mutex> lock(window_mutex);
+        stopping = true;
+    }
+    window_started.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // 依核心順序彙總，與 thread 數量無關
+    MultiCoreResult result;
+    result.completed_processes = 0;
+    result.context_switches = 0;
+    result.migrations = 0;
+    result.makespan = 0;
+    for (auto& core : cores) {
+        CpuUsage usage = core->sim.get_cpu_usage();
+        result.cores.push_back(CoreStats{usage.busy, usage.switching, core->sim.get_dispatches(),
+                                         core->sim.get_context_switches(), core->migrations_in, core->steals});
+        result.completed_processes += core->completed_processes;
+        result.context_switches += core->sim.get_context_switches();
+        result.migrations += core->migrations_in;
+        result.makespan = max(result.makespan, core->makespan);
+        result.latency.merge(core->latency);
+    }
+    return result;
+}
+
+MultiCoreResult run_multicore(ArrivalSource& source, const MultiCoreConfig& config) {
+    MultiCoreSimulator sim(source, config);
+    return sim.run();
+}
+
+void print_multicore_result(const MultiCoreResult& result, const MultiCoreConfig& config) {
+    cout << "\n--- Multi-core: " << config.num_cores << " cores, " << load_balancing_name(config.balancing) << ", ";
+    cout << config.policy;
+    if (config.policy == "rr") {
+        cout << " (quantum " << config.params.rr.quantum << "ms)";
+    }
+    cout << " ---\n";
+    cout << "Completed Processes: " << result.completed_processes << "\n";
+    cout << "Average Turnaround Time: " << result.latency.turnaround.mean() << " ms\n";
+    cout << "Average Waiting Time: " << result.latency.waiting.mean() << " ms\n";
+    cout << "Average Response Time: " << result.latency.response.mean() << " ms\n";
+    cout << "Context Switches: " << result.context_switches << "\n";
+    cout << "Migrations: " << result.migrations << "\n";
+    cout << "Makespan: " << result.makespan << " ms\n";
+    SimTime switching = 0;
+    for (const CoreStats& stats : result.cores) switching += stats.switch_time;
+    if (switching > 0 && result.makespan > 0) {
+        cout << "Switch Overhead: " << switching << " ms ("
+             << 100.0 * switching / (result.makespan * (SimTime)result.cores.size()) << "% of core time)\n";
+    }
+
+    cout << "Core | Utilisation | Dispatches | Context Switches | Migrations In | Steals\n";
+    cout << "-----------------------------------------------------------------------------\n";
+    streamsize precision = cout.precision();
+    for (size_t c = 0; c < result.cores.size(); c++) {
+        const CoreStats& stats = result.cores[c];
+        double utilisation = result.makespan > 0 ? 100.0 * stats.busy_time / result.makespan : 0;
+        cout << setw(4) << c << " | "
+             << setw(9) << fixed << setprecision(1) << utilisation << " % | "
+             << defaultfloat << setprecision(precision)
+             << setw(10) << stats.dispatches << " | "
+             << setw(16) << stats.context_switches << " | "
+             << setw(13) << stats.migrations_in << " | "
+             << setw(6) << stats.steals << "\n";
+    }
+    cout << "-----------------------------------------------------------------------------\n";
+    print_latency_stats(result.latency);
+}
@@ -0,0 +1,77 @@
+#include "output_pipeline.h"
+#include <iostream>
+
+using namespace std;
+
+bool OutputFile::open(const string& filename) {
+    file = fopen(filename.c_str(), "wb");
+    if (file == nullptr) return false;
+    owns_file = true;
+    failed = false;
+    return true;
+}
+
+void OutputFile::open_stdout() {
+    cout.flush();
+    file = stdout;
+    owns_file = false;
+    failed = false;
+}
+
+bool OutputFile::close() {
+    if (!is_open()) return false;
+    if (fflush(file) != 0) failed = true;
+    if (owns_file && fclose(file) != 0) failed = true;
+    file = nullptr;
+    return !failed;
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+    if (is_open()) close();
+}
+
+bool AsyncFileWriter::open(const string& filename) {
+    if (is_open()) close();
+    if (!file.open(filename)) return false;
+    start();
+    return true;
+}
+
+void AsyncFileWriter::open_stdout() {
+    if (is_open()) close();
+    file.open_stdout();
+    start();
+}
+
+void AsyncFileWriter::start() {
+    block.reserve(BLOCK_SIZE);
+    pipeline.start([this](string& data) { file.write(data.data(), data.size()); });
+}
+
+void AsyncFileWriter::flush_block() {
+    if (block.empty()) return;
+    pipeline.submit(block);
+    block.reserve(BLOCK_SIZE); // 沒有用過的 block 可以回收時是新的空字串
+}
+
+bool AsyncFileWriter::close() {
+    if (!is_open()) return false;
+    flush_block();
+    pipeline.finish();
+    return file.close();
+}
+
+GanttCsvWriter::GanttCsvWriter(const string& filename) : filename(filename) {
+    if (!output.open(filename, "Start,End,ProcessID\n")) { // 含 CSV 標頭
+        cerr << "Error: Could not open file " << filename << " for writing Gantt chart data." << endl;
+    }
+}
+
+void GanttCsvWriter::close() {
+    if (!is_open()) return;
+    if (!output.close()) {
+        cerr << "Error: Failed to write Gantt chart data to " << filename << endl;
+        return;
+    }
+    cout << "Gantt chart data saved to " << filename << endl;
+}
@@ -1,27 +1,152 @@
-#include "process.h"
-#include <random>
-
-// Process constructor
-Process::Process(int _id, int _arrival, int _burst, int _priority)
-    : id(_id), arrival_time(_arrival), burst_time(_burst), priority(_priority),
-      remaining_burst_time(_burst), start_time(-1), completion_time(-1),
-      last_run_time(_arrival), is_started(false) {}
-
-std::vector<Process> generate_processes(int num_processes) {
-    std::vector<Process> processes;
-    std::random_device rd;
-    std::mt19937 gen(rd()); // Mersenne Twister algo: generate random number
-
-    std::vector<int> arrival_options = {0, 5, 10}; // arrival time options
-    std::uniform_int_distribution<> burst_dist(6, 28); // burst time [6, 28]
-    std::uniform_int_distribution<> priority_dist(1, 3); // priority [1, 3]
-
-    for (int i = 0; i < num_processes; i++) {
-        int id = i + 1;
-        int arrival = arrival_options[gen() % arrival_options.size()];
-        int burst = burst_dist(gen);
-        int priority = priority_dist(gen);
-        processes.emplace_back(id, arrival, burst, priority);
-    }
-    return processes;
-}
+#include "process.h"
+#include <random>
+
+// Process constructor
+Process::Process(int _id, SimTime _arrival, SimTime _burst, int _priority, SimTime _deadline)
+    : id(_id), arrival_time(_arrival), burst_time(_burst), priority(_priority), deadline(_deadline),
+      io_time(0), remaining_burst_time(_burst), start_time(-1), completion_time(-1),
+      last_run_time(_arrival), is_started(false) {}
+
+void Process::set_bursts(const std::vector<SimTime>& sequence) {
+    burst_time = 0;
+    io_time = 0;
+    for (size_t i = 0; i < sequence.size(); i++) {
+        (i % 2 == 0 ? burst_time : io_time) += sequence[i];
+    }
+    remaining_burst_time = sequence.empty() ? 0 : sequence[0];
+    if (sequence.size() > 1) {
+        bursts = sequence;
+    } else {
+        bursts.clear();
+    }
+}
+
+void ProcessTable::reserve(size_t n) {
+    id.reserve(n);
+    priority.reserve(n);
+    arrival_time.reserve(n);
+    burst_time.reserve(n);
+    deadline.reserve(n);
+    bursts.reserve(n);
+    burst_index.reserve(n);
+    io_time.reserve(n);
+    remaining_burst_time.reserve(n);
+    start_time.reserve(n);
+    completion_time.reserve(n);
+    last_run_time.reserve(n);
+    off_cpu_time.reserve(n);
+}
+
+void ProcessTable::resize(size_t n) {
+    id.resize(n);
+    priority.resize(n);
+    arrival_time.resize(n);
+    burst_time.resize(n);
+    deadline.resize(n);
+    bursts.resize(n);
+    burst_index.resize(n);
+    io_time.resize(n);
+    remaining_burst_time.resize(n);
+    start_time.resize(n);
+    completion_time.resize(n);
+    last_run_time.resize(n);
+    off_cpu_time.resize(n);
+}
+
+void ProcessTable::clear() {
+    resize(0);
+}
+
+void ProcessTable::push_back(const Process& p) {
+    id.push_back(p.id);
+    priority.push_back(static_cast<std::int16_t>(p.priority));
+    arrival_time.push_back(p.arrival_time);
+    burst_time.push_back(p.burst_time);
+    deadline.push_back(p.deadline);
+    bursts.push_back(p.bursts);
+    burst_index.push_back(0);
+    io_time.push_back(p.io_time);
+    remaining_burst_time.push_back(p.remaining_burst_time);
+    start_time.push_back(p.is_started ? p.start_time : -1);
+    completion_time.push_back(p.completion_time);
+    last_run_time.push_back(p.last_run_time);
+    off_cpu_time.push_back(-1);
+}
+
+void ProcessTable::assign(size_t i, const Process& p) {
+    id[i] = p.id;
+    priority[i] = static_cast<std::int16_t>(p.priority);
+    arrival_time[i] = p.arrival_time;
+    burst_time[i] = p.burst_time;
+    deadline[i] = p.deadline;
+    bursts[i] = p.bursts;
+    burst_index[i] = 0;
+    io_time[i] = p.io_time;
+    remaining_burst_time[i] = p.remaining_burst_time;
+    start_time[i] = p.is_started ? p.start_time : -1;
+    completion_time[i] = p.completion_time;
+    last_run_time[i] = p.last_run_time;
+    off_cpu_time[i] = -1;
+}
+
+void ProcessTable::assign(size_t i, const ProcessTable& other, size_t j) {
+    id[i] = other.id[j];
+    priority[i] = other.priority[j];
+    arrival_time[i] = other.arrival_time[j];
+    burst_time[i] = other.burst_time[j];
+    deadline[i] = other.deadline[j];
+    bursts[i] = other.bursts[j];
+    burst_index[i] = other.burst_index[j];
+    io_time[i] = other.io_time[j];
+    remaining_burst_time[i] = other.remaining_burst_time[j];
+    start_time[i] = other.start_time[j];
+    completion_time[i] = other.completion_time[j];
+    last_run_time[i] = other.last_run_time[j];
+    off_cpu_time[i] = other.off_cpu_time[j];
+}
+
+void ProcessTable::append(const ProcessTable& other, size_t i) {
+    id.push_back(other.id[i]);
+    priority.push_back(other.priority[i]);
+    arrival_time.push_back(other.arrival_time[i]);
+    burst_time.push_back(other.burst_time[i]);
+    deadline.push_back(other.deadline[i]);
+    bursts.push_back(other.bursts[i]);
+    burst_index.push_back(other.burst_index[i]);
+    io_time.push_back(other.io_time[i]);
+    remaining_burst_time.push_back(other.remaining_burst_time[i]);
+    start_time.push_back(other.start_time[i]);
+    completion_time.push_back(other.completion_time[i]);
+    last_run_time.push_back(other.last_run_time[i]);
+    off_cpu_time.push_back(other.off_cpu_time[i]);
+}
+
+Process ProcessTable::row(size_t i) const {
+    Process p(id[i], arrival_time[i], burst_time[i], priority[i], deadline[i]);
+    p.bursts = bursts[i];
+    p.io_time = io_time[i];
+    p.remaining_burst_time = remaining_burst_time[i];
+    p.start_time = start_time[i];
+    p.completion_time = completion_time[i];
+    p.last_run_time = last_run_time[i];
+    p.is_started = start_time[i] != -1;
+    return p;
+}
+
+std::vector<Process> generate_processes(int num_processes, unsigned int seed) {
+    std::vector<Process> processes;
+    std::mt19937 gen(seed); // Mersenne Twister algo: generate random number
+
+    std::vector<int> arrival_options = {0, 5, 10}; // arrival time options
+    std::uniform_int_distribution<> burst_dist(6, 28); // burst time [6, 28]
+    std::uniform_int_distribution<> priority_dist(1, 3); // priority [1, 3]
+
+    for (int i = 0; i < num_processes; i++) {
+        int id = i + 1;
+        int arrival = arrival_options[gen() % arrival_options.size()];
+        int burst = burst_dist(gen);
+        int priority = priority_dist(gen);
+        processes.emplace_back(id, arrival, burst, priority);
+    }
+    return processes;
+}
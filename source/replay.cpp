@@ -0,0 +1,207 @@
+#include "replay.h"
+#include "utils.h"
+#include "output_pipeline.h"
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+SchedulingResult simulate(const Workload& workload, const SchedulerCore& scheduler, SimulationArena* arena,
+                          GanttSink* gantt_sink, bool record_gantt) {
+    SchedulingResult result;
+    result.processes.resize(workload.size());
+
+    SimulationArena local_arena;
+    SimulationArena& state = arena != nullptr ? *arena : local_arena;
+
+    // admission 順序就是 workload 的列索引 (WorkloadSource 依列的順序提供行程)
+    WorkloadSource source(workload);
+    EventSimulator sim(source, [&](const ProcessTable& table, int idx) {
+        result.processes.assign(workload.result_position(state.admission_index[idx]), table, idx);
+    }, record_gantt, &state);
+    if (!record_gantt) gantt_sink = nullptr;
+    if (gantt_sink != nullptr) {
+        sim.stream_gantt_to(gantt_sink);
+    }
+    scheduler(sim);
+    result.context_switches = sim.get_context_switches();
+    result.cpu_usage = sim.get_cpu_usage();
+    if (gantt_sink != nullptr) {
+        sim.flush_gantt();
+    } else if (record_gantt) {
+        result.gantt_timeline = sim.get_gantt_timeline();
+    }
+    result.telemetry = sim.get_telemetry();
+    return result;
+}
+
+SchedulingResult simulate_with_gantt_file(const Workload& workload, const SchedulerCore& scheduler,
+                                          const string& gantt_prefix, GanttFormat format) {
+    if (format == GANTT_BINARY) {
+        SchedulingResult result = simulate(workload, scheduler);
+        save_gantt_chart_data_to_binary(result.gantt_timeline, gantt_prefix + "_gantt_data.bin");
+        return result;
+    }
+    GanttCsvWriter gantt_csv(gantt_prefix + "_gantt_data.csv");
+    SchedulingResult result = simulate(workload, scheduler, nullptr, gantt_csv.sink());
+    gantt_csv.close();
+    return result;
+}
+
+// 重播中累計的統計，checkpoint 時寫在模擬器狀態的前面
+struct ReplayTotals {
+    long long completed_processes;
+    double total_turnaround_time;
+    double total_waiting_time;
+    SimTime makespan;
+    LatencyStats latency;
+
+    ReplayTotals() : completed_processes(0), total_turnaround_time(0), total_waiting_time(0), makespan(0) {}
+
+    void record(const ProcessTable& table, int idx) {
+        SimTime turnaround_time = table.completion_time[idx] - table.arrival_time[idx];
+        total_turnaround_time += turnaround_time;
+        total_waiting_time += turnaround_time - table.burst_time[idx] - table.io_time[idx];
+        completed_processes++;
+        makespan = max(makespan, table.completion_time[idx]);
+        latency.record(table, idx);
+    }
+    void save(SnapshotWriter& out) const {
+        out.put(completed_processes);
+        out.put(total_turnaround_time);
+        out.put(total_waiting_time);
+        out.put(makespan);
+        latency.save(out);
+    }
+    void load(SnapshotReader& in) {
+        in.get(completed_processes);
+        in.get(total_turnaround_time);
+        in.get(total_waiting_time);
+        in.get(makespan);
+        latency.load(in);
+    }
+};
+
+// 把 checkpoint 寫到檔案 (前面加上重播的統計)
+class ReplayCheckpointSink : public CheckpointSink {
+public:
+    ReplayCheckpointSink(const ReplayTotals& totals, const string& algorithm, CheckpointWriter& writer)
+        : totals(totals), algorithm(algorithm), writer(writer) {}
+
+    void write_checkpoint(SimTime time, const string& state) override {
+        SnapshotWriter out;
+        totals.save(out);
+        writer.write(time, algorithm, out.bytes() + state);
+    }
+
+private:
+    const ReplayTotals& totals;
+    const string& algorithm;
+    CheckpointWriter& writer;
+};
+
+// prepare 在排程核心開始之前設定模擬器 (checkpoint / resume)
+static ReplaySummary run_replay(ArrivalSource& source, const SchedulerCore& scheduler, ReplayTotals& totals,
+                                const function<void(EventSimulator&)>& prepare, bool* resume_failed = nullptr) {
+    EventSimulator sim(source, [&](const ProcessTable& table, int idx) { totals.record(table, idx); }, false);
+    if (prepare) prepare(sim);
+    scheduler(sim);
+    if (resume_failed != nullptr) *resume_failed = sim.resume_failed();
+
+    ReplaySummary summary = ReplaySummary{totals.completed_processes, 0, 0, 0, totals.makespan,
+                                          CpuUsage{0, 0, 0, 0}, totals.latency};
+    if (summary.completed_processes > 0) {
+        summary.avg_turnaround_time = totals.total_turnaround_time / summary.completed_processes;
+        summary.avg_waiting_time = totals.total_waiting_time / summary.completed_processes;
+    }
+    summary.context_switches = sim.get_context_switches();
+    summary.cpu_usage = sim.get_cpu_usage();
+    return summary;
+}
+
+ReplaySummary replay(ArrivalSource& source, const SchedulerCore& scheduler) {
+    ReplayTotals totals;
+    return run_replay(source, scheduler, totals, nullptr);
+}
+
+ReplaySummary replay_with_checkpoints(ArrivalSource& source, const SchedulerCore& scheduler, const string& algorithm,
+                                      SimTime interval, CheckpointWriter& writer) {
+    ReplayTotals totals;
+    ReplayCheckpointSink sink(totals, algorithm, writer);
+    return run_replay(source, scheduler, totals, [&](EventSimulator& sim) { sim.checkpoint_every(interval, &sink); });
+}
+
+bool resume_replay(ArrivalSource& source, const SchedulerCore& scheduler, const Checkpoint& checkpoint,
+                   ReplaySummary& summary) {
+    ReplayTotals totals;
+    SnapshotReader in(checkpoint.state);
+    totals.load(in);
+    if (in.failed()) {
+        cerr << "Error: checkpoint at time " << checkpoint.time << " is corrupted" << endl;
+        return false;
+    }
+    string sim_state = checkpoint.state.substr(in.position()); // 模擬器只保留參考，需要活到重播結束
+    bool failed = false;
+    summary = run_replay(source, scheduler, totals, [&](EventSimulator& sim) { sim.resume_from(sim_state); }, &failed);
+    if (failed) {
+        cerr << "Error: checkpoint at time " << checkpoint.time << " does not match the " << checkpoint.algorithm
+             << " scheduler" << endl;
+        return false;
+    }
+    return true;
+}
+
+SchedulerCore with_switch_cost(const SchedulerCore& scheduler, const SwitchCostModel& model) {
+    if (model.dispatch == 0 && model.cache_warmup == 0) return scheduler;
+    return [scheduler, model](EventSimulator& sim) {
+        sim.set_switch_cost(model);
+        scheduler(sim);
+    };
+}
+
+SchedulerParams default_scheduler_params() {
+    return SchedulerParams{default_rr_priority_config(), default_mlfq_config(), default_aging_config(),
+                           default_cfs_config()};
+}
+
+SchedulerCore scheduler_by_name(const string& name, const SchedulerParams& params) {
+    if (name == "sjf") return schedule_preemptive_sjf;
+    if (name == "rr") {
+        RRPriorityConfig config = params.rr;
+        return [config](EventSimulator& sim) { schedule_rr_priority(sim, config); };
+    }
+    if (name == "mlfq") {
+        MLFQConfig config = params.mlfq;
+        return [config](EventSimulator& sim) { schedule_multilevel_feedback_queue(sim, config); };
+    }
+    if (name == "custom") {
+        AgingConfig config = params.aging;
+        return [config](EventSimulator& sim) { schedule_custom_priority_sjf_aging(sim, config); };
+    }
+    if (name == "cfs") {
+        CFSConfig config = params.cfs;
+        return [config](EventSimulator& sim) { schedule_cfs(sim, config); };
+    }
+    if (name == "edf") {
+        return [](EventSimulator& sim) { schedule_edf(sim, default_edf_config()); };
+    }
+    if (name == "edf-hybrid") {
+        return [](EventSimulator& sim) { schedule_edf(sim, EDFConfig{true}); };
+    }
+    return SchedulerCore();
+}
+
+SchedulerCore scheduler_by_name(const string& name) {
+    return scheduler_by_name(name, default_scheduler_params());
+}
+
+void print_replay_summary(const ReplaySummary& summary, const string& algo_name) {
+    cout << "\n--- " << algo_name << " Replay Results ---\n";
+    cout << "Completed Processes: " << summary.completed_processes << "\n";
+    cout << "Average Turnaround Time: " << summary.avg_turnaround_time << " ms\n";
+    cout << "Average Waiting Time: " << summary.avg_waiting_time << " ms\n";
+    cout << "Context Switches: " << summary.context_switches << "\n";
+    cout << "Makespan: " << summary.makespan << " ms\n";
+    print_cpu_usage(summary.cpu_usage, summary.completed_processes, summary.makespan);
+    print_latency_stats(summary.latency);
+}
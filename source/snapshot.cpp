@@ -0,0 +1,43 @@
+#include "snapshot.h"
+
+using namespace std;
+
+void SnapshotWriter::put(const ProcessTable& table) {
+    put(table.id);
+    put(table.priority);
+    put(table.arrival_time);
+    put(table.burst_time);
+    put(table.deadline);
+    put(table.bursts);
+    put(table.burst_index);
+    put(table.io_time);
+    put(table.remaining_burst_time);
+    put(table.start_time);
+    put(table.completion_time);
+    put(table.last_run_time);
+    put(table.off_cpu_time);
+}
+
+void SnapshotReader::get(ProcessTable& table) {
+    get(table.id);
+    get(table.priority);
+    get(table.arrival_time);
+    get(table.burst_time);
+    get(table.deadline);
+    get(table.bursts);
+    get(table.burst_index);
+    get(table.io_time);
+    get(table.remaining_burst_time);
+    get(table.start_time);
+    get(table.completion_time);
+    get(table.last_run_time);
+    get(table.off_cpu_time);
+    // 每個欄位的長度必須相同
+    size_t n = table.id.size();
+    if (table.priority.size() != n || table.arrival_time.size() != n || table.burst_time.size() != n ||
+        table.deadline.size() != n || table.bursts.size() != n || table.burst_index.size() != n ||
+        table.io_time.size() != n || table.remaining_burst_time.size() != n || table.start_time.size() != n ||
+        table.completion_time.size() != n || table.last_run_time.size() != n || table.off_cpu_time.size() != n) {
+        failed_read = true;
+    }
+}
@@ -0,0 +1,233 @@
+#include "sweep.h"
+#include "replay.h"
+#include "thread_pool.h"
+#include "latency_stats.h"
+#include "generator.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <random>
+#include <memory>
+#include <map>
+
+using namespace std;
+
+SweepAlgorithm sweep_algorithm(const string& name, const SchedulerCore& scheduler, const SwitchCostModel& switch_cost) {
+    SchedulerCore core = with_switch_cost(scheduler, switch_cost);
+    return SweepAlgorithm{name, [core](const Workload& w, SimulationArena* arena) {
+        return simulate(w, core, arena, nullptr, false); // sweep 只需要統計，不記錄甘特圖
+    }};
+}
+
+vector<SweepAlgorithm> default_sweep_algorithms(const SwitchCostModel& switch_cost) {
+    return grid_sweep_algorithms(SweepGrid(), switch_cost);
+}
+
+// 空的 list 表示只用預設值 (以 -1 表示，不加到名稱)
+static vector<int> grid_values(const vector<int>& values) {
+    return values.empty() ? vector<int>{-1} : values;
+}
+
+// "MLFQ" + {"q0=5", "boost=50"} -> "MLFQ (q0=5 boost=50)"
+static string grid_name(const string& base, const vector<string>& parts) {
+    if (parts.empty()) return base;
+    string name = base + " (";
+    for (size_t i = 0; i < parts.size(); i++) {
+        if (i > 0) name += " "; // 名稱也會寫進 CSV，不能有逗號
+        name += parts[i];
+    }
+    return name + ")";
+}
+
+vector<SweepAlgorithm> grid_sweep_algorithms(const SweepGrid& grid, const SwitchCostModel& switch_cost) {
+    vector<SweepAlgorithm> algorithms;
+    algorithms.push_back(sweep_algorithm("Preemptive SJF", scheduler_by_name("sjf"), switch_cost));
+    for (int quantum : grid_values(grid.quantums)) {
+        SchedulerParams params = default_scheduler_params();
+        vector<string> parts;
+        if (quantum != -1) {
+            params.rr.quantum = quantum;
+            parts.push_back("q=" + to_string(quantum));
+        }
+        algorithms.push_back(sweep_algorithm(grid_name("RR + Priority", parts), scheduler_by_name("rr", params),
+                                             switch_cost));
+    }
+    // MLFQ：Q0 x Q1，預設的 boost 之後再加上 mlfq_boosts 的變體 (放在最後，與沒有 grid 時的順序相同)
+    auto add_mlfq = [&](int boost) {
+        for (int q0 : grid_values(grid.quantums)) {
+            for (int q1 : grid_values(grid.q1_quantums)) {
+                SchedulerParams params = default_scheduler_params();
+                vector<string> parts;
+                if (q0 != -1) {
+                    params.mlfq.levels[0].quantum = q0;
+                    parts.push_back("q0=" + to_string(q0));
+                }
+                if (q1 != -1) {
+                    params.mlfq.levels[1].quantum = q1;
+                    parts.push_back("q1=" + to_string(q1));
+                }
+                if (boost != -1) {
+                    params.mlfq.boost_interval = boost;
+                    parts.push_back("boost=" + to_string(boost));
+                }
+                algorithms.push_back(sweep_algorithm(grid_name("MLFQ", parts), scheduler_by_name("mlfq", params),
+                                                     switch_cost));
+            }
+        }
+    };
+    add_mlfq(-1);
+    for (int threshold : grid_values(grid.thresholds)) {
+        for (int boost : grid_values(grid.boosts)) {
+            SchedulerParams params = default_scheduler_params();
+            vector<string> parts;
+            if (threshold != -1) {
+                params.aging.threshold = threshold;
+                parts.push_back("threshold=" + to_string(threshold));
+            }
+            if (boost != -1) {
+                params.aging.priority_boost = boost;
+                parts.push_back("boost=" + to_string(boost));
+            }
+            algorithms.push_back(sweep_algorithm(grid_name("Custom", parts), scheduler_by_name("custom", params),
+                                                 switch_cost));
+        }
+    }
+    algorithms.push_back(sweep_algorithm("CFS", scheduler_by_name("cfs"), switch_cost));
+    for (int boost : grid.mlfq_boosts) {
+        add_mlfq(boost);
+    }
+    return algorithms;
+}
+
+// 每個 (seed, num_processes) 組合有獨立且固定的 RNG stream
+static unsigned int workload_seed(unsigned int seed, int num_processes) {
+    seed_seq seq{seed, static_cast<unsigned int>(num_processes)};
+    unsigned int derived;
+    seq.generate(&derived, &derived + 1);
+    return derived;
+}
+
+static void summarize(const SchedulingResult& result, SweepRow& row) {
+    double total_turnaround_time = 0;
+    double total_waiting_time = 0;
+    SimTime makespan = 0;
+    LatencyHistogram waiting;
+    const ProcessTable& processes = result.processes;
+    for (size_t i = 0; i < processes.size(); i++) {
+        SimTime turnaround_time = processes.completion_time[i] - processes.arrival_time[i];
+        total_turnaround_time += turnaround_time;
+        SimTime waiting_time = turnaround_time - processes.burst_time[i] - processes.io_time[i];
+        total_waiting_time += waiting_time;
+        waiting.record(waiting_time);
+        makespan = max(makespan, processes.completion_time[i]);
+    }
+    size_t n = max<size_t>(1, result.processes.size());
+    row.avg_turnaround_time = total_turnaround_time / n;
+    row.avg_waiting_time = total_waiting_time / n;
+    row.p99_waiting_time = waiting.percentile(99);
+    row.context_switches = result.context_switches;
+    row.makespan = makespan;
+}
+
+vector<SweepRow> run_sweep(const SweepConfig& config) {
+    size_t num_algorithms = config.algorithms.size();
+    size_t num_workloads = config.seeds.size() * config.process_counts.size();
+    vector<SweepRow> rows(num_workloads * num_algorithms);
+
+    WorkStealingPool pool(config.num_threads);
+
+    size_t workload_index = 0;
+    for (unsigned int seed : config.seeds) {
+        for (int num_processes : config.process_counts) {
+            size_t base = workload_index++ * num_algorithms;
+            // 產生 workload 本身也是一個工作，完成後再把各演算法的工作送進 pool
+            pool.submit([&config, &rows, &pool, base, seed, num_processes, num_algorithms]() {
+                shared_ptr<const Workload> workload = make_shared<const Workload>(
+                    generate_processes(default_workload_spec(num_processes, workload_seed(seed, num_processes))));
+                for (size_t a = 0; a < num_algorithms; a++) {
+                    pool.submit([&config, &rows, workload, base, a, seed, num_processes]() {
+                        static thread_local SimulationArena arena; // 每個 worker thread 重複使用
+                        SweepRow& row = rows[base + a]; // 每個工作只寫自己的位置，不需要 lock
+                        row.seed = seed;
+                        row.num_processes = num_processes;
+                        row.algorithm = config.algorithms[a].name;
+                        summarize(config.algorithms[a].run(*workload, &arena), row);
+                    });
+                }
+            });
+        }
+    }
+
+    pool.wait();
+    return rows;
+}
+
+void print_sweep_table(const vector<SweepRow>& rows) {
+    struct Totals {
+        int runs;
+        double turnaround;
+        double waiting;
+        double p99_waiting;
+        double context_switches;
+        double makespan;
+    };
+    // 依第一次出現的順序輸出
+    vector<pair<int, string>> order;
+    map<pair<int, string>, Totals> totals;
+    for (const auto& row : rows) {
+        pair<int, string> key(row.num_processes, row.algorithm);
+        if (totals.find(key) == totals.end()) {
+            order.push_back(key);
+            totals[key] = Totals{0, 0, 0, 0, 0, 0};
+        }
+        Totals& t = totals[key];
+        t.runs++;
+        t.turnaround += row.avg_turnaround_time;
+        t.waiting += row.avg_waiting_time;
+        t.p99_waiting += row.p99_waiting_time;
+        t.context_switches += row.context_switches;
+        t.makespan += row.makespan;
+    }
+
+    // 參數 grid 的名稱可能比較長，演算法欄位至少 20 個字元
+    size_t name_width = 20;
+    for (const auto& key : order) {
+        name_width = max(name_width, key.second.size());
+    }
+    string rule = string(116 + name_width - 20, '-') + "\n";
+
+    cout << "\n--- Sweep Summary (mean over seeds) ---\n";
+    cout << " Processes | " << left << setw(name_width) << "Algorithm" << right
+         << " | Runs | Avg Turnaround | Avg Waiting | P99 Waiting | Context Switches |   Makespan\n";
+    cout << rule;
+    for (const auto& key : order) {
+        const Totals& t = totals[key];
+        cout << setw(10) << key.first << " | "
+             << left << setw(name_width) << key.second << right << " | "
+             << setw(4) << t.runs << " | "
+             << setw(14) << t.turnaround / t.runs << " | "
+             << setw(11) << t.waiting / t.runs << " | "
+             << setw(11) << t.p99_waiting / t.runs << " | "
+             << setw(16) << t.context_switches / t.runs << " | "
+             << setw(10) << t.makespan / t.runs << "\n";
+    }
+    cout << rule;
+}
+
+void save_sweep_results_to_csv(const vector<SweepRow>& rows, const string& filename) {
+    ofstream outfile(filename);
+    if (!outfile.is_open()) {
+        cerr << "Error: Could not open file " << filename << " for writing sweep results." << endl;
+        return;
+    }
+
+    outfile << "Seed,Processes,Algorithm,AvgTurnaround,AvgWaiting,P99Waiting,ContextSwitches,Makespan\n";
+    for (const auto& row : rows) {
+        outfile << row.seed << "," << row.num_processes << "," << row.algorithm << ","
+                << row.avg_turnaround_time << "," << row.avg_waiting_time << "," << row.p99_waiting_time << ","
+                << row.context_switches << "," << row.makespan << "\n";
+    }
+
+    outfile.close();
+    cout << "Sweep results saved to " << filename << endl;
+}
@@ -0,0 +1,107 @@
+#include "telemetry.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+
+using namespace std;
+
+double Telemetry::idle_fraction() const {
+    SimTime total = busy_time + idle_time;
+    return total > 0 ? static_cast<double>(idle_time) / total : 0;
+}
+
+void print_telemetry_summary(const Telemetry& telemetry) {
+    long long max_ready = 0;
+    for (const auto& sample : telemetry.get_ready_queue()) {
+        max_ready = max(max_ready, sample.value);
+    }
+
+    cout << "Preemptions: " << telemetry.get_preemptions() << "\n";
+    cout << "CPU Idle Fraction: " << telemetry.idle_fraction() * 100 << " %\n";
+    cout << "Max Ready Queue Length: " << max_ready << "\n";
+    cout << "Simulator Time (selection / bookkeeping): "
+         << telemetry.get_selection_ns() / 1000.0 << " us / "
+         << telemetry.get_bookkeeping_ns() / 1000.0 << " us\n";
+}
+
+static void write_series_json(ofstream& outfile, const vector<TelemetrySample>& series) {
+    outfile << "[";
+    for (size_t i = 0; i < series.size(); i++) {
+        outfile << (i == 0 ? "" : ", ") << "[" << series[i].time << ", " << series[i].value << "]";
+    }
+    outfile << "]";
+}
+
+void save_telemetry_to_json(const Telemetry& telemetry, const string& algo_name, const string& filename) {
+    ofstream outfile(filename);
+    if (!outfile.is_open()) {
+        cerr << "Error: Could not open file " << filename << " for writing telemetry." << endl;
+        return;
+    }
+
+    outfile << "{\n";
+    outfile << "  \"algorithm\": \"" << algo_name << "\",\n";
+    outfile << "  \"preemptions\": " << telemetry.get_preemptions() << ",\n";
+    outfile << "  \"busy_time\": " << telemetry.get_busy_time() << ",\n";
+    outfile << "  \"idle_time\": " << telemetry.get_idle_time() << ",\n";
+    outfile << "  \"idle_fraction\": " << telemetry.idle_fraction() << ",\n";
+    outfile << "  \"selection_ns\": " << telemetry.get_selection_ns() << ",\n";
+    outfile << "  \"bookkeeping_ns\": " << telemetry.get_bookkeeping_ns() << ",\n";
+    outfile << "  \"ready_queue\": ";
+    write_series_json(outfile, telemetry.get_ready_queue());
+    outfile << ",\n  \"level_occupancy\": [";
+    const vector<vector<TelemetrySample>>& levels = telemetry.get_level_occupancy();
+    for (size_t level = 0; level < levels.size(); level++) {
+        outfile << (level == 0 ? "\n    " : ",\n    ");
+        write_series_json(outfile, levels[level]);
+    }
+    outfile << (levels.empty() ? "]\n" : "\n  ]\n");
+    outfile << "}\n";
+
+    outfile.close();
+    cout << "Telemetry saved to " << filename << endl;
+}
+
+void save_telemetry_to_csv(const Telemetry& telemetry, const string& filename) {
+    ofstream outfile(filename);
+    if (!outfile.is_open()) {
+        cerr << "Error: Could not open file " << filename << " for writing telemetry." << endl;
+        return;
+    }
+
+    // 第 0 個是 ready queue，之後是各層佔用量
+    vector<const vector<TelemetrySample>*> series;
+    series.push_back(&telemetry.get_ready_queue());
+    outfile << "Time,ReadyQueue";
+    const vector<vector<TelemetrySample>>& levels = telemetry.get_level_occupancy();
+    for (size_t level = 0; level < levels.size(); level++) {
+        series.push_back(&levels[level]);
+        outfile << ",Level" << level;
+    }
+    outfile << "\n";
+
+    // 所有序列的時間點合併後依序輸出，每個序列沿用最近一次的值 (step function)
+    vector<SimTime> times;
+    for (const auto* s : series) {
+        for (const auto& sample : *s) times.push_back(sample.time);
+    }
+    sort(times.begin(), times.end());
+    times.erase(unique(times.begin(), times.end()), times.end());
+
+    vector<size_t> cursor(series.size(), 0);
+    vector<long long> value(series.size(), 0);
+    for (SimTime t : times) {
+        outfile << t;
+        for (size_t i = 0; i < series.size(); i++) {
+            const vector<TelemetrySample>& s = *series[i];
+            while (cursor[i] < s.size() && s[cursor[i]].time <= t) {
+                value[i] = s[cursor[i]++].value;
+            }
+            outfile << "," << value[i];
+        }
+        outfile << "\n";
+    }
+
+    outfile.close();
+    cout << "Telemetry saved to " << filename << endl;
+}
@@ -0,0 +1,93 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+using namespace std;
+
+WorkStealingPool::WorkStealingPool(unsigned int num_threads)
+    : next_queue(0), queued_tasks(0), pending_tasks(0), stopping(false) {
+    if (num_threads == 0) {
+        num_threads = max(1u, thread::hardware_concurrency());
+    }
+    queues = vector<WorkQueue>(num_threads);
+    for (unsigned int i = 0; i < num_threads; i++) {
+        workers.emplace_back(&WorkStealingPool::worker_loop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        lock_guard<mutex> lock(state_mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(function<void()> task) {
+    // round-robin 分配到各 worker 的 deque
+    unsigned int target = next_queue++ % queues.size();
+    {
+        lock_guard<mutex> lock(queues[target].mutex);
+        queues[target].tasks.push_back(move(task));
+    }
+    {
+        lock_guard<mutex> lock(state_mutex);
+        queued_tasks++;
+        pending_tasks++;
+    }
+    work_available.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    unique_lock<mutex> lock(state_mutex);
+    all_done.wait(lock, [this] { return pending_tasks == 0; });
+}
+
+bool WorkStealingPool::try_pop(unsigned int self, function<void()>& task) {
+    // 先從自己的尾端取 (LIFO，cache 比較熱)
+    {
+        lock_guard<mutex> lock(queues[self].mutex);
+        if (!queues[self].tasks.empty()) {
+            task = move(queues[self].tasks.back());
+            queues[self].tasks.pop_back();
+            return true;
+        }
+    }
+    // 再從其他 worker 的前端偷
+    for (size_t i = 1; i < queues.size(); i++) {
+        WorkQueue& victim = queues[(self + i) % queues.size()];
+        lock_guard<mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::worker_loop(unsigned int self) {
+    while (true) {
+        {
+            unique_lock<mutex> lock(state_mutex);
+            work_available.wait(lock, [this] { return stopping || queued_tasks > 0; });
+            if (queued_tasks == 0) return; // stopping 且沒有剩下的工作
+            queued_tasks--; // 預留一個工作，保證下面一定拿得到
+        }
+
+        function<void()> task;
+        while (!try_pop(self, task)) {
+            this_thread::yield();
+        }
+        task();
+
+        {
+            lock_guard<mutex> lock(state_mutex);
+            if (--pending_tasks == 0) {
+                all_done.notify_all();
+            }
+        }
+    }
+}
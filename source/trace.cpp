@@ -0,0 +1,285 @@
+#include "trace.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <climits>
+
+using namespace std;
+
+static const uint32_t TRACE_VERSION = 1;
+static const uint32_t TRACE_VERSION_DEADLINES = 2; // 每筆記錄多一個 deadline
+static const uint32_t TRACE_VERSION_BURSTS = 3;    // 再多一個 burst 序列
+static const int32_t MAX_TRACE_BURSTS = 1 << 20;   // binary 記錄中 burst 序列的長度上限 (檢查檔案損毀)
+
+TraceReader::TraceReader(const string& filename, size_t chunk_size)
+    : infile(filename, ios::binary), filename(filename), format(TRACE_CSV), binary_fields(4), binary_bursts(false),
+      chunk_size(max<size_t>(1, chunk_size)), chunk_pos(0), opened(false), eof(false), error(false),
+      last_arrival_time(0), record_number(0) {
+    if (!infile.is_open()) {
+        cerr << "Error: Could not open trace file " << filename << endl;
+        eof = true;
+        return;
+    }
+    opened = true;
+
+    char magic[4] = {0, 0, 0, 0};
+    infile.read(magic, 4);
+    if (infile.gcount() == 4 && memcmp(magic, "TRCE", 4) == 0) {
+        format = TRACE_BINARY;
+        uint32_t version = 0;
+        infile.read(reinterpret_cast<char*>(&version), sizeof(version));
+        if (version == TRACE_VERSION_DEADLINES || version == TRACE_VERSION_BURSTS) {
+            binary_fields = 5;
+            binary_bursts = version == TRACE_VERSION_BURSTS;
+        } else if (version != TRACE_VERSION) {
+            fail("unsupported binary trace version");
+        }
+    } else {
+        format = TRACE_CSV;
+        infile.clear();
+        infile.seekg(0);
+    }
+}
+
+// CSV 欄位之後只能是下一個欄位或行尾 ("5xyz" 不是數字)
+static bool at_field_end(const char* end) {
+    return *end == '\0' || *end == '\r' || *end == ',';
+}
+
+void TraceReader::fail(const string& message) {
+    cerr << "Error: " << filename << " (record " << record_number << "): " << message << endl;
+    error = true;
+    eof = true;
+}
+
+bool TraceReader::read_record(Process& p) {
+    if (format == TRACE_BINARY) {
+        int32_t record[5] = {0, 0, 0, 0, -1};
+        streamsize record_size = binary_fields * sizeof(int32_t);
+        infile.read(reinterpret_cast<char*>(record), record_size);
+        if (infile.gcount() == 0) return false;
+        if (infile.gcount() != record_size) {
+            fail("truncated record");
+            return false;
+        }
+        p = Process(record[0], record[1], record[2], record[3], record[4]);
+        if (binary_bursts) {
+            int32_t count = 0;
+            infile.read(reinterpret_cast<char*>(&count), sizeof(count));
+            if (infile.gcount() != sizeof(count) || count < 0 || count > MAX_TRACE_BURSTS) {
+                fail("truncated or invalid burst sequence");
+                return false;
+            }
+            vector<int32_t> values(count);
+            infile.read(reinterpret_cast<char*>(values.data()), count * sizeof(int32_t));
+            if (infile.gcount() != (streamsize)(count * sizeof(int32_t))) {
+                fail("truncated burst sequence");
+                return false;
+            }
+            sequence.assign(values.begin(), values.end());
+            return set_sequence(p);
+        }
+        return true;
+    }
+
+    string line;
+    while (getline(infile, line)) {
+        if (line.empty() || line[0] == '\r') continue;
+        if (!isdigit(static_cast<unsigned char>(line[0])) && line[0] != '-') continue; // 標頭
+        const char* cursor = line.c_str();
+        char* end = nullptr;
+        long long fields[4];
+        for (int i = 0; i < 4; i++) {
+            fields[i] = strtoll(cursor, &end, 10);
+            if (end == cursor || !at_field_end(end) || (i < 3 && *end != ',')) {
+                fail("expected ProcessID,ArrivalTime,BurstTime,Priority");
+                return false;
+            }
+            cursor = end + 1;
+        }
+        SimTime deadline = -1;
+        sequence.clear();
+        if (*end == ',') { // 選擇性的 Deadline 欄位
+            cursor = end + 1;
+            deadline = strtoll(cursor, &end, 10);
+            if (end == cursor) deadline = -1; // 空白也表示沒有 deadline
+            if (!at_field_end(end)) {
+                fail("Deadline must be a number");
+                return false;
+            }
+            if (*end == ',') { // 選擇性的 Bursts 欄位
+                cursor = end + 1;
+                while (true) {
+                    SimTime value = strtoll(cursor, &end, 10);
+                    if (end == cursor) break;
+                    sequence.push_back(value);
+                    if (*end != ';') break;
+                    cursor = end + 1;
+                }
+                if (*end != '\0' && *end != '\r') {
+                    fail("Bursts must look like 5;10;3");
+                    return false;
+                }
+            }
+        }
+        // 先檢查範圍再轉成 int，超出範圍的值不能被截斷成合法的值
+        if (fields[0] < INT_MIN || fields[0] > INT_MAX) {
+            fail("ProcessID is out of the int range");
+            return false;
+        }
+        if (fields[3] < 0 || fields[3] > INT16_MAX) {
+            fail("priority must be in [0, 32767]");
+            return false;
+        }
+        p = Process(static_cast<int>(fields[0]), fields[1], fields[2], static_cast<int>(fields[3]), deadline);
+        return set_sequence(p);
+    }
+    return false;
+}
+
+// 套用 sequence 中讀到的 burst 序列 (空的表示純 CPU 的行程)
+bool TraceReader::set_sequence(Process& p) {
+    if (sequence.empty()) return true;
+    SimTime stated_burst_time = p.burst_time;
+    if (sequence.size() % 2 == 0) {
+        fail("burst sequence must alternate CPU and I/O and end with a CPU burst");
+        return false;
+    }
+    for (SimTime burst : sequence) {
+        if (burst <= 0) {
+            fail("bursts must be positive");
+            return false;
+        }
+    }
+    p.set_bursts(sequence);
+    if (p.burst_time != stated_burst_time) {
+        fail("BurstTime does not match the CPU bursts of the sequence");
+        return false;
+    }
+    return true;
+}
+
+void TraceReader::refill() {
+    chunk.clear();
+    chunk_pos = 0;
+    Process p(0, 0, 0, 0);
+    while (!eof && chunk.size() < chunk_size) {
+        if (!read_record(p)) {
+            eof = true;
+            break;
+        }
+        record_number++;
+        if (p.arrival_time < last_arrival_time) {
+            fail("arrival times are not sorted");
+            break;
+        }
+        if (p.burst_time <= 0) {
+            fail("burst time must be positive");
+            break;
+        }
+        if (p.priority < 0 || p.priority > INT16_MAX) {
+            // ProcessTable 以 int16 存放 priority，RR / custom 以 priority 當作層級，不能是負的
+            fail("priority must be in [0, 32767]");
+            break;
+        }
+        if (p.deadline <= 0 && p.deadline != -1) {
+            fail("deadline must be positive (or -1 for none)");
+            break;
+        }
+        last_arrival_time = p.arrival_time;
+        chunk.push_back(p);
+    }
+}
+
+bool TraceReader::has_next() {
+    if (chunk_pos == chunk.size()) {
+        refill();
+    }
+    return chunk_pos < chunk.size();
+}
+
+SimTime TraceReader::peek_arrival_time() {
+    return chunk[chunk_pos].arrival_time;
+}
+
+Process TraceReader::next() {
+    return chunk[chunk_pos++];
+}
+
+TraceWriter::TraceWriter(const string& filename, TraceFormat format, bool with_deadlines, bool with_io)
+    : format(format), with_deadlines(with_deadlines || with_io), with_io(with_io) {
+    if (!output.open(filename)) {
+        cerr << "Error: Could not open file " << filename << " for writing trace." << endl;
+        return;
+    }
+    if (format == TRACE_BINARY) {
+        output.write("TRCE", 4);
+        const uint32_t& version = with_io ? TRACE_VERSION_BURSTS
+                                : with_deadlines ? TRACE_VERSION_DEADLINES : TRACE_VERSION;
+        output.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    } else {
+        output.write(with_io ? "ProcessID,ArrivalTime,BurstTime,Priority,Deadline,Bursts\n"
+                     : with_deadlines ? "ProcessID,ArrivalTime,BurstTime,Priority,Deadline\n"
+                                      : "ProcessID,ArrivalTime,BurstTime,Priority\n");
+    }
+}
+
+void TraceWriter::write(const Process& p) {
+    if (format == TRACE_BINARY) {
+        const int32_t record[5] = {p.id, static_cast<int32_t>(p.arrival_time),
+                                   static_cast<int32_t>(p.burst_time), p.priority,
+                                   static_cast<int32_t>(p.deadline)};
+        output.write(reinterpret_cast<const char*>(record), (with_deadlines ? 5 : 4) * sizeof(int32_t));
+        if (with_io) {
+            const int32_t count = p.bursts.size();
+            output.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            for (SimTime burst : p.bursts) {
+                const int32_t value = static_cast<int32_t>(burst);
+                output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+        }
+    } else {
+        output.write_int(p.id);
+        output.put(',');
+        output.write_int(p.arrival_time);
+        output.put(',');
+        output.write_int(p.burst_time);
+        output.put(',');
+        output.write_int(p.priority);
+        if (with_deadlines) {
+            output.put(',');
+            output.write_int(p.deadline);
+        }
+        if (with_io) {
+            output.put(',');
+            for (size_t i = 0; i < p.bursts.size(); i++) {
+                if (i > 0) output.put(';');
+                output.write_int(p.bursts[i]);
+            }
+        }
+        output.put('\n');
+    }
+}
+
+bool save_processes_to_trace(const vector<Process>& processes, const string& filename, TraceFormat format) {
+    bool with_deadlines = any_of(processes.begin(), processes.end(), [](const Process& p) {
+        return p.deadline != -1;
+    });
+    bool with_io = any_of(processes.begin(), processes.end(), [](const Process& p) { return !p.bursts.empty(); });
+    TraceWriter writer(filename, format, with_deadlines, with_io);
+    if (!writer.is_open()) return false;
+
+    VectorArrivalSource source(processes); // 依 arrival time 排序
+    while (source.has_next()) {
+        writer.write(source.next());
+    }
+    if (!writer.close()) {
+        cerr << "Error: Failed to write trace to " << filename << endl;
+        return false;
+    }
+    cout << "Trace saved to " << filename << endl;
+    return true;
+}
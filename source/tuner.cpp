@@ -0,0 +1,179 @@
+#include "tuner.h"
+#include "replay.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+using namespace std;
+
+vector<TuningCandidate> rr_priority_grid(const vector<int>& quantums) {
+    vector<TuningCandidate> candidates;
+    for (int quantum : quantums) {
+        TuningCandidate candidate = TuningCandidate{default_rr_priority_config(), default_mlfq_config(),
+                                                    default_aging_config()};
+        candidate.rr.quantum = quantum;
+        candidates.push_back(candidate);
+    }
+    return candidates;
+}
+
+vector<TuningCandidate> mlfq_grid(const vector<int>& q0_quantums, const vector<int>& q1_quantums) {
+    vector<TuningCandidate> candidates;
+    for (int q0 : q0_quantums) {
+        for (int q1 : q1_quantums) {
+            if (q1 < q0) continue; // 較低的層級 quantum 不會比較短
+            TuningCandidate candidate = TuningCandidate{default_rr_priority_config(), default_mlfq_config(),
+                                                        default_aging_config()};
+            candidate.mlfq.levels[0].quantum = q0;
+            candidate.mlfq.levels[1].quantum = q1;
+            candidates.push_back(candidate);
+        }
+    }
+    return candidates;
+}
+
+vector<TuningCandidate> aging_grid(const vector<int>& thresholds, const vector<int>& boosts) {
+    vector<TuningCandidate> candidates;
+    for (int threshold : thresholds) {
+        for (int boost : boosts) {
+            TuningCandidate candidate = TuningCandidate{default_rr_priority_config(), default_mlfq_config(),
+                                                        default_aging_config()};
+            candidate.aging.threshold = threshold;
+            candidate.aging.priority_boost = boost;
+            candidates.push_back(candidate);
+        }
+    }
+    return candidates;
+}
+
+static SchedulerCore candidate_core(TunedAlgorithm algorithm, const TuningCandidate& candidate) {
+    switch (algorithm) {
+    case TUNE_RR_PRIORITY:
+        return [&candidate](EventSimulator& sim) { schedule_rr_priority(sim, candidate.rr); };
+    case TUNE_MLFQ:
+        return [&candidate](EventSimulator& sim) { schedule_multilevel_feedback_queue(sim, candidate.mlfq); };
+    case TUNE_CUSTOM:
+        return [&candidate](EventSimulator& sim) { schedule_custom_priority_sjf_aging(sim, candidate.aging); };
+    }
+    return SchedulerCore();
+}
+
+// 一個 workload 的 objective (不需要保留每個行程的結果，也不記錄甘特圖)
+static double evaluate(const SchedulerCore& core, const Workload& workload, const TuningObjective& objective) {
+    WorkloadSource source(workload);
+    ReplaySummary summary = replay(source, core);
+    double switches_per_process = summary.completed_processes > 0
+        ? (double)summary.context_switches / summary.completed_processes : 0;
+    return summary.latency.waiting.percentile(objective.waiting_percentile) +
+           objective.context_switch_penalty * switches_per_process;
+}
+
+vector<TuningResult> run_tuner(const TunerConfig& config, const vector<Workload>& workloads) {
+    vector<TuningResult> results(config.candidates.size(), TuningResult{0, 0, false});
+
+    // 目前完整評估過的最佳候選 (受 best_mutex 保護)
+    mutex best_mutex;
+    double best_objective = numeric_limits<double>::infinity();
+    size_t best_index = config.candidates.size();
+
+    WorkStealingPool pool(config.num_threads);
+    for (size_t c = 0; c < config.candidates.size(); c++) {
+        pool.submit([&, c]() {
+            SchedulerCore core = with_switch_cost(candidate_core(config.algorithm, config.candidates[c]),
+                                                  config.switch_cost);
+            TuningResult& result = results[c]; // 每個工作只寫自己的位置
+            for (const Workload& workload : workloads) {
+                result.objective += evaluate(core, workload, config.objective);
+                result.workloads_evaluated++;
+
+                // 累計值已經比最佳值差，後面的 workload 只會讓它更差
+                lock_guard<mutex> lock(best_mutex);
+                if (result.objective > best_objective) {
+                    result.pruned = result.workloads_evaluated < workloads.size();
+                    return;
+                }
+            }
+            lock_guard<mutex> lock(best_mutex);
+            if (result.objective < best_objective || (result.objective == best_objective && c < best_index)) {
+                best_objective = result.objective;
+                best_index = c;
+            }
+        });
+    }
+    pool.wait();
+    return results;
+}
+
+size_t best_candidate(const vector<TuningResult>& results) {
+    size_t best = results.size();
+    for (size_t c = 0; c < results.size(); c++) {
+        if (results[c].pruned) continue;
+        if (best == results.size() || results[c].objective < results[best].objective) best = c;
+    }
+    return best;
+}
+
+string describe_candidate(TunedAlgorithm algorithm, const TuningCandidate& candidate) {
+    switch (algorithm) {
+    case TUNE_RR_PRIORITY:
+        return "quantum=" + to_string(candidate.rr.quantum);
+    case TUNE_MLFQ:
+        return "q0=" + to_string(candidate.mlfq.levels[0].quantum) + " q1=" + to_string(candidate.mlfq.levels[1].quantum);
+    case TUNE_CUSTOM:
+        return "threshold=" + to_string(candidate.aging.threshold) + " boost=" + to_string(candidate.aging.priority_boost);
+    }
+    return "";
+}
+
+void print_tuning_results(const TunerConfig& config, const vector<TuningResult>& results, size_t top) {
+    vector<size_t> ranked;
+    long long simulations = 0;
+    for (size_t c = 0; c < results.size(); c++) {
+        simulations += results[c].workloads_evaluated;
+        if (!results[c].pruned) ranked.push_back(c);
+    }
+    stable_sort(ranked.begin(), ranked.end(), [&](size_t a, size_t b) {
+        return results[a].objective < results[b].objective;
+    });
+
+    cout << "\n--- Tuning Results (objective = p" << config.objective.waiting_percentile << " waiting + "
+         << config.objective.context_switch_penalty << " x context switches per process) ---\n";
+    cout << "Candidates: " << results.size() << ", pruned early: " << results.size() - ranked.size()
+         << ", simulations run: " << simulations << "\n";
+    cout << "Rank | Parameters                 |    Objective\n";
+    cout << "-------------------------------------------------\n";
+    for (size_t r = 0; r < ranked.size() && r < top; r++) {
+        size_t c = ranked[r];
+        cout << setw(4) << r + 1 << " | "
+             << left << setw(26) << describe_candidate(config.algorithm, config.candidates[c]) << right << " | "
+             << setw(12) << results[c].objective << "\n";
+    }
+    cout << "-------------------------------------------------\n";
+    size_t best = best_candidate(results);
+    if (best < results.size()) {
+        cout << "Best: " << describe_candidate(config.algorithm, config.candidates[best]) << "\n";
+    }
+}
+
+void save_tuning_results_to_csv(const TunerConfig& config, const vector<TuningResult>& results,
+                                const string& filename) {
+    ofstream outfile(filename);
+    if (!outfile.is_open()) {
+        cerr << "Error: Could not open file " << filename << " for writing tuning results." << endl;
+        return;
+    }
+
+    outfile << "Candidate,Parameters,Objective,WorkloadsEvaluated,Pruned\n";
+    for (size_t c = 0; c < results.size(); c++) {
+        outfile << c << "," << describe_candidate(config.algorithm, config.candidates[c]) << ","
+                << results[c].objective << "," << results[c].workloads_evaluated << ","
+                << (results[c].pruned ? 1 : 0) << "\n";
+    }
+
+    outfile.close();
+    cout << "Tuning results saved to " << filename << endl;
+}
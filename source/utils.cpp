@@ -1,94 +1,161 @@
-#include "utils.h"
-#include <iostream>
-#include <iomanip>
-#include <numeric> // For std::accumulate (if used for sums)
-#include <algorithm> // For std::sort (if used for sorting results by ID)
-#include <fstream> // For file operations
-
-using namespace std;
-
-void print_results(const vector<Process>& processes, int context_switches, const string& algo_name) {
-    cout << "\n--- " << algo_name << " Results ---\n";
-
-    double total_waiting_time = 0;
-    double total_turnaround_time = 0;
-
-    cout << "Process ID | Arrival Time | Burst Time | Completion Time | Turnaround Time | Waiting Time\n";
-    cout << "-----------------------------------------------------------------------------------------\n";
-
-    for (const auto& p : processes) {
-        // Turnaround Time (Ti) = Completion Time (Ci) - Arrival Time (Ai)
-        int turnaround_time = p.completion_time - p.arrival_time;
-
-        // Waiting Time (Wi) = Turnaround Time (Ti) - Burst Time (Bi)
-        int waiting_time = turnaround_time - p.burst_time;
-
-        total_waiting_time += waiting_time;
-        total_turnaround_time += turnaround_time;
-
-        cout << setw(10) << p.id << " | "
-             << setw(12) << p.arrival_time << " | "
-             << setw(10) << p.burst_time << " | "
-             << setw(15) << p.completion_time << " | "
-             << setw(15) << turnaround_time << " | "
-             << setw(12) << waiting_time << "\n";
-    }
-
-    cout << "-----------------------------------------------------------------------------------------\n";
-    cout << "Average Turnaround Time: " << total_turnaround_time / processes.size() << " ms\n";
-    cout << "Average Waiting Time: " << total_waiting_time / processes.size() << " ms\n";
-    cout << "Context Switches: " << context_switches << "\n";
-}
-
-void print_gantt_chart(const map<int, int>& gantt_chart_data) {
-    cout << "\nGantt Chart:\n";
-    if (gantt_chart_data.empty()) {
-        cout << "  [Empty]\n";
-        return;
-    }
-
-    // 找出最大時間點
-    int max_time = 0;
-    for (const auto& entry : gantt_chart_data) {
-        if (entry.first > max_time) {
-            max_time = entry.first;
-        }
-    }
-
-    cout << "Time:   ";
-    for (int t = 0; t <= max_time; t++) {
-        cout << setw(4) << t;
-    }
-    cout << "\n";
-
-    cout << "Process:";
-    for (int t = 0; t <= max_time; t++) {
-        auto it = gantt_chart_data.find(t);
-        int current_proc_id = (it != gantt_chart_data.end()) ? it->second : -1;
-
-        if (current_proc_id == -1) {
-            cout << setw(4) << "-"; // 表示CPU空閒
-        } else {
-            cout << setw(4) << current_proc_id;
-        }
-    }
-    cout << "\n";
-}
-    // 新增：將甘特圖數據存到 CSV
-void save_gantt_chart_data_to_csv(const map<int, int>& gantt_chart_data, const string& filename) {
-    ofstream outfile(filename);
-    if (!outfile.is_open()) {
-        cerr << "Error: Could not open file " << filename << " for writing Gantt chart data." << endl;
-        return;
-    }
-
-    outfile << "Time,ProcessID\n"; // CSV 標頭
-
-    // 由於 map 是按鍵排序的，可以直接遍歷
-    for (const auto& entry : gantt_chart_data) {
-        outfile << entry.first << "," << entry.second << "\n";
-    }
-
-    outfile.close();
-    cout << "Gantt chart data saved to " << filename << endl;
-}
+#include "utils.h"
+#include "latency_stats.h"
+#include "output_pipeline.h"
+#include <iostream>
+#include <iomanip>
+#include <numeric> // For std::accumulate (if used for sums)
+#include <algorithm> // For std::sort (if used for sorting results by ID)
+#include <fstream> // For file operations
+#include <cstdint>
+
+using namespace std;
+
+// 結果表的一列：模擬的 thread 只複製數值，由背景 thread 格式化
+struct ResultRow {
+    long long id;
+    SimTime arrival_time;
+    SimTime burst_time;
+    SimTime completion_time;
+    SimTime turnaround_time;
+    SimTime waiting_time;
+};
+
+struct ResultRowFormat {
+    void operator()(const ResultRow& row, string& out) const {
+        append_int(out, row.id, 10);
+        out.append(" | ", 3);
+        append_int(out, row.arrival_time, 12);
+        out.append(" | ", 3);
+        append_int(out, row.burst_time, 10);
+        out.append(" | ", 3);
+        append_int(out, row.completion_time, 15);
+        out.append(" | ", 3);
+        append_int(out, row.turnaround_time, 15);
+        out.append(" | ", 3);
+        append_int(out, row.waiting_time, 12);
+        out.push_back('\n');
+    }
+};
+
+void print_results(const ProcessTable& processes, long long context_switches, const CpuUsage& usage,
+                   const string& algo_name) {
+    cout << "\n--- " << algo_name << " Results ---\n";
+
+    double total_waiting_time = 0;
+    double total_turnaround_time = 0;
+    SimTime makespan = 0;
+    LatencyStats latency; // 百分位數用 histogram 統計
+
+    cout << "Process ID | Arrival Time | Burst Time | Completion Time | Turnaround Time | Waiting Time\n";
+    cout << "-----------------------------------------------------------------------------------------\n";
+
+    // 每個行程一列，行程很多時由背景 thread 格式化並輸出，格式化不經過 iostream
+    AsyncRecordWriter<ResultRow, ResultRowFormat> table;
+    table.open_stdout();
+    for (size_t i = 0; i < processes.size(); i++) {
+        // Turnaround Time (Ti) = Completion Time (Ci) - Arrival Time (Ai)
+        SimTime turnaround_time = processes.completion_time[i] - processes.arrival_time[i];
+
+        // Waiting Time (Wi) = Turnaround Time (Ti) - Burst Time (Bi) - I/O Time
+        SimTime waiting_time = turnaround_time - processes.burst_time[i] - processes.io_time[i];
+
+        total_waiting_time += waiting_time;
+        total_turnaround_time += turnaround_time;
+        makespan = max(makespan, processes.completion_time[i]);
+        latency.record(processes, i);
+
+        table.write(ResultRow{processes.id[i], processes.arrival_time[i], processes.burst_time[i],
+                              processes.completion_time[i], turnaround_time, waiting_time});
+    }
+    table.close();
+
+    cout << "-----------------------------------------------------------------------------------------\n";
+    cout << "Average Turnaround Time: " << total_turnaround_time / processes.size() << " ms\n";
+    cout << "Average Waiting Time: " << total_waiting_time / processes.size() << " ms\n";
+    cout << "Average Response Time: " << latency.response.mean() << " ms\n";
+    cout << "Context Switches: " << context_switches << "\n";
+    print_cpu_usage(usage, processes.size(), makespan);
+    print_latency_stats(latency);
+}
+
+void print_cpu_usage(const CpuUsage& usage, long long completed_processes, SimTime makespan) {
+    if (makespan <= 0) return;
+    cout << "CPU Utilization: " << 100.0 * usage.busy / makespan << "%\n";
+    if (usage.switching > 0) {
+        cout << "Switch Overhead: " << usage.switching << " ms (" << 100.0 * usage.switching / makespan << "%)\n";
+    }
+    cout << "Throughput: " << 1000.0 * completed_processes / makespan << " jobs/sec\n"; // 模擬時間的單位是 ms
+    if (usage.io_active > 0) {
+        cout << "I/O Overlap: " << 100.0 * usage.overlap / usage.io_active << "%\n";
+    }
+}
+
+void print_gantt_chart(const GanttTimeline& gantt_timeline) {
+    cout << "\nGantt Chart:\n";
+    if (gantt_timeline.empty()) {
+        cout << "  [Empty]\n";
+        return;
+    }
+
+    SimTime max_time = gantt_timeline.end_time() - 1;
+
+    cout << "Time:   ";
+    for (SimTime t = 0; t <= max_time; t++) {
+        cout << setw(4) << t;
+    }
+    cout << "\n";
+
+    cout << "Process:";
+    SimTime t = 0;
+    for (const auto& seg : gantt_timeline.get_segments()) {
+        for (; t < seg.start; t++) {
+            cout << setw(4) << "-"; // 沒有記錄的時間點
+        }
+        for (; t < seg.end; t++) {
+            if (seg.process_id == -1) {
+                cout << setw(4) << "-"; // 表示CPU空閒
+            } else if (seg.process_id == GANTT_SWITCH) {
+                cout << setw(4) << "*"; // 表示 context switch
+            } else {
+                cout << setw(4) << seg.process_id;
+            }
+        }
+    }
+    cout << "\n";
+}
+    // 新增：將甘特圖數據存到 CSV
+void save_gantt_chart_data_to_csv(const GanttTimeline& gantt_timeline, const string& filename) {
+    GanttCsvWriter writer(filename); // 含 CSV 標頭
+    if (!writer.is_open()) return;
+
+    // 區間已按時間排序，可以直接遍歷
+    for (const auto& seg : gantt_timeline.get_segments()) {
+        writer.write_segment(seg);
+    }
+    writer.close();
+}
+
+void save_gantt_chart_data_to_binary(const GanttTimeline& gantt_timeline, const string& filename) {
+    ofstream outfile(filename, ios::binary);
+    if (!outfile.is_open()) {
+        cerr << "Error: Could not open file " << filename << " for writing Gantt chart data." << endl;
+        return;
+    }
+
+    const vector<GanttSegment>& segments = gantt_timeline.get_segments();
+    const uint32_t version = 2;
+    const uint64_t count = segments.size();
+    outfile.write("GNTT", 4);
+    outfile.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    outfile.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+    for (const auto& seg : segments) {
+        const int64_t times[2] = {seg.start, seg.end};
+        const int32_t pid = seg.process_id;
+        outfile.write(reinterpret_cast<const char*>(times), sizeof(times));
+        outfile.write(reinterpret_cast<const char*>(&pid), sizeof(pid));
+    }
+
+    outfile.close();
+    cout << "Gantt chart data saved to " << filename << endl;
+}
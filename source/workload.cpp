@@ -0,0 +1,94 @@
+#include "workload.h"
+#include <algorithm>
+
+using namespace std;
+
+Workload::Workload(const vector<Process>& processes) {
+    size_t n = processes.size();
+    vector<int> order(n);
+    for (size_t i = 0; i < n; i++) {
+        order[i] = i;
+    }
+    // stable sort: 同時到達的行程維持原本的索引順序
+    stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return processes[a].arrival_time < processes[b].arrival_time;
+    });
+
+    ids.reserve(n);
+    arrival_times.reserve(n);
+    burst_times.reserve(n);
+    priorities.reserve(n);
+    deadlines.reserve(n);
+    for (int i : order) {
+        ids.push_back(processes[i].id);
+        arrival_times.push_back(processes[i].arrival_time);
+        burst_times.push_back(processes[i].burst_time);
+        priorities.push_back(static_cast<int16_t>(processes[i].priority));
+        deadlines.push_back(processes[i].deadline);
+    }
+    bool any_io = any_of(processes.begin(), processes.end(), [](const Process& p) { return !p.bursts.empty(); });
+    if (any_io) {
+        sequence_offsets.reserve(n + 1);
+        sequence_offsets.push_back(0);
+        for (int i : order) {
+            sequence_pool.insert(sequence_pool.end(), processes[i].bursts.begin(), processes[i].bursts.end());
+            sequence_offsets.push_back(sequence_pool.size());
+        }
+    }
+
+    // 結果依 ID 排序 (ID 相同時依 arrival 順序)，以便 print_results 函數使用
+    vector<int> by_id(n);
+    for (size_t row = 0; row < n; row++) {
+        by_id[row] = row;
+    }
+    stable_sort(by_id.begin(), by_id.end(), [this](int a, int b) {
+        return ids[a] < ids[b];
+    });
+    result_positions.resize(n);
+    for (size_t position = 0; position < n; position++) {
+        result_positions[by_id[position]] = position;
+    }
+}
+
+Process Workload::process(size_t row) const {
+    Process p(ids[row], arrival_times[row], burst_times[row], priorities[row], deadlines[row]);
+    if (has_io() && sequence_offsets[row] != sequence_offsets[row + 1]) {
+        // 序列至少有 CPU, I/O, CPU 三段 (只有一個 CPU burst 時不會存進 sequence_pool)
+        p.bursts.assign(sequence_pool.begin() + sequence_offsets[row], sequence_pool.begin() + sequence_offsets[row + 1]);
+        p.io_time = io_time(row);
+        p.remaining_burst_time = p.bursts[0];
+    }
+    return p;
+}
+
+void Workload::write_row(size_t row, ProcessTable& table, size_t slot) const {
+    table.id[slot] = ids[row];
+    table.priority[slot] = priorities[row];
+    table.arrival_time[slot] = arrival_times[row];
+    table.burst_time[slot] = burst_times[row];
+    table.deadline[slot] = deadlines[row];
+    table.burst_index[slot] = 0;
+    if (has_io() && sequence_offsets[row] != sequence_offsets[row + 1]) {
+        table.bursts[slot].assign(sequence_pool.begin() + sequence_offsets[row],
+                                  sequence_pool.begin() + sequence_offsets[row + 1]);
+        table.io_time[slot] = io_time(row);
+        table.remaining_burst_time[slot] = table.bursts[slot][0];
+    } else {
+        table.bursts[slot].clear();
+        table.io_time[slot] = 0;
+        table.remaining_burst_time[slot] = burst_times[row];
+    }
+    table.start_time[slot] = -1;
+    table.completion_time[slot] = -1;
+    table.last_run_time[slot] = arrival_times[row];
+    table.off_cpu_time[slot] = -1;
+}
+
+// 序列中奇數位置 (I/O burst) 的總和
+SimTime Workload::io_time(size_t row) const {
+    SimTime total = 0;
+    for (int64_t i = sequence_offsets[row] + 1; i < sequence_offsets[row + 1]; i += 2) {
+        total += sequence_pool[i];
+    }
+    return total;
+}